@@ -30,13 +30,40 @@ SOFTWARE.
 
 #include"_test.hpp"
 #include"io.hpp"
+#include"binary_io.hpp"
+#include"async_save.hpp"
+#include"chunked_file.hpp"
+#include"compression.hpp"
+#include"crc32c.hpp"
+#include"delta_save.hpp"
+#include"serial_struct.hpp"
+#include"string_table.hpp"
+#include"updating_field_history.hpp"
+#include"updating_field_pool.hpp"
 #include<maths/random.hpp>
 #include<iostream>
 #include<algorithm>
 #include<cstdio>
 #include<vector>
+#include<list>
+#include<map>
+#include<set>
+#include<sstream>
 #include<stdexcept>
 #include<limits>
+
+// structs for the serial struct tests, whose field lists must be at global scope
+struct serial_packed_t { int32_t id; float x, y; uint16_t health, armour; };
+GAME_DEV_UTILITIES_SERIAL_FIELDS_5(serial_packed_t, id, x, y, health, armour)
+struct serial_padded_t { uint8_t kind; double weight; };
+GAME_DEV_UTILITIES_SERIAL_FIELDS_2(serial_padded_t, kind, weight)
+struct serial_reordered_t { float a, b; };
+GAME_DEV_UTILITIES_SERIAL_FIELDS_2(serial_reordered_t, b, a)
+struct serial_nested_t { serial_packed_t packed; std::string name; int64_t score; };
+GAME_DEV_UTILITIES_SERIAL_FIELDS_3(serial_nested_t, packed, name, score)
+struct serial_virtual_t { virtual ~serial_virtual_t() {} int32_t a, b; };
+GAME_DEV_UTILITIES_SERIAL_FIELDS_2(serial_virtual_t, a, b)
+
 namespace game_dev_utilities
 {
 
@@ -120,8 +147,8 @@ void fill_collection(std::vector<T> & collection, const unsigned int fill_count)
     collection.push_back(std::numeric_limits<T>::min()+std::numeric_limits<T>::max()/2.0);
 }
 
-template<typename T>
-void write_collection(std::ostream&out, const std::vector<T> & collection)
+template<typename Out, typename T>
+void write_collection(Out&out, const std::vector<T> & collection)
 {
     for (typename std::vector<T>::const_iterator itr = collection.begin(); itr!=collection.end();++itr)
     {
@@ -131,8 +158,8 @@ void write_collection(std::ostream&out, const std::vector<T> & collection)
 
 
 
-template<typename C>
-unsigned int comparative_read(std::istream&in, const C & collection)
+template<typename In, typename C>
+unsigned int comparative_read(In&in, const C & collection)
 {
     unsigned int matches = 0;
     for (typename C::const_iterator itr = collection.begin(); itr!=collection.end();++itr)
@@ -250,12 +277,641 @@ void run_test()
         in.close();
     }
     
+    {
+        std::string stream_written;
+        std::ifstream in(test_filename, std::ios::binary);
+        copy_file_to_string(in, stream_written);
+        in.close();
+        
+        std::vector<char> buffer_written;
+        {
+            memory_sink_t sink(buffer_written);
+            binary_writer_t out(sink);
+            
+            write_collection(out, strings);
+            write_collection(out, int64s);
+            write_collection(out, int32s);
+            write_collection(out, int16s);
+            write_collection(out, uint64s);
+            write_collection(out, uint32s);
+            write_collection(out, uint16s);    
+            write_collection(out, floats);    
+            write(out, int64s);
+            write(out, int32s);
+            write(out, int16s);
+            write(out, uint64s);
+            write(out, uint32s);
+            write(out, uint16s);
+            write(out, floats);
+        }
+        
+        std::cout << "Comparing buffered writer output: "
+            << (stream_written == std::string(buffer_written.begin(), buffer_written.end())? "Matched.":"Match Failed.") << std::endl;
+        
+        binary_reader_t reader(stream_written.data(), stream_written.size());
+        std::cout << "Comparing buffered reader strings: " << comparative_read(reader, strings)
+            << " out of " << strings.size() << " successfully matched." << std::endl;        
+        std::cout << "Comparing buffered reader int64s: " << comparative_read(reader, int64s)
+            << " out of " << int64s.size() << " successfully matched." << std::endl;
+    }
+
+    {
+        std::vector<double> doubles(floats.begin(), floats.end());
+        std::vector<std::vector<int32_t> > nested(4, int32s);
+        nested[1].clear();
+        std::map<std::string, std::vector<float> > named;
+        std::set<uint16_t> unique(uint16s.begin(), uint16s.end());
+        std::list<std::pair<int16_t, std::string> > pairs;
+        std::vector<bool> flags;
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            named[strings[i]] = floats;
+            pairs.push_back(std::make_pair(int16s[i], strings[i]));
+            flags.push_back(strings[i].size() % 2 == 0);
+        }
+
+        std::ostringstream stream_out(std::ios::binary);
+        write(stream_out, doubles);
+        write(stream_out, nested);
+        write(stream_out, named);
+        write(stream_out, unique);
+        write(stream_out, pairs);
+        write(stream_out, flags);
+        write(stream_out, strings);
+
+        std::vector<char> buffer_written;
+        {
+            memory_sink_t sink(buffer_written);
+            binary_writer_t out(sink);
+            write(out, doubles);
+            write(out, nested);
+            write(out, named);
+            write(out, unique);
+            write(out, pairs);
+            write(out, flags);
+            write(out, strings);
+        }
+
+        const std::string stream_written = stream_out.str();
+        std::cout << "Comparing buffered writer container output: "
+            << (stream_written == std::string(buffer_written.begin(), buffer_written.end())? "Matched.":"Match Failed.") << std::endl;
+
+        std::istringstream in(stream_written, std::ios::binary);
+        std::vector<double> doubles_copy;
+        std::vector<std::vector<int32_t> > nested_copy;
+        std::map<std::string, std::vector<float> > named_copy;
+        std::set<uint16_t> unique_copy;
+        std::list<std::pair<int16_t, std::string> > pairs_copy;
+        std::vector<bool> flags_copy;
+        std::vector<std::string> strings_copy;
+        read(in, doubles_copy);
+        read(in, nested_copy);
+        read(in, named_copy);
+        read(in, unique_copy);
+        read(in, pairs_copy);
+        read(in, flags_copy);
+        read(in, strings_copy);
+
+        std::cout << "Comparing stored containers: "
+            << (doubles == doubles_copy && nested == nested_copy && named == named_copy && unique == unique_copy
+                && pairs == pairs_copy && flags == flags_copy && strings == strings_copy? "Matched.":"Match Failed.") << std::endl;
+
+        binary_reader_t reader(buffer_written.data(), buffer_written.size());
+        nested_copy.clear();
+        named_copy.clear();
+        strings_copy.clear();
+        read(reader, doubles_copy);
+        read(reader, nested_copy);
+        read(reader, named_copy);
+        std::cout << "Comparing buffered reader containers: "
+            << (doubles_copy.size() == 2 * doubles.size() && nested == nested_copy && named == named_copy? "Matched.":"Match Failed.") << std::endl;
+
+        // more than one read block, then counts far beyond the data, which
+        // must fail without allocating for the count and leave the vectors as they were
+        std::vector<int32_t> large(3 * container_read_block / 2 + 7);
+        for (std::size_t i = 0; i < large.size(); ++i)
+        {
+            large[i] = static_cast<int32_t>(i * 7);
+        }
+        std::ostringstream large_out;
+        write(large_out, large);
+        std::istringstream large_in(large_out.str());
+        std::vector<int32_t> large_copy;
+        read(large_in, large_copy);
+
+        std::ostringstream corrupt_out;
+        write(corrupt_out, static_cast<uint32_t>(0x7FFFFFFF));
+        write(corrupt_out, static_cast<uint32_t>(5));
+        const std::string corrupt = corrupt_out.str();
+        std::istringstream corrupt_strings_in(corrupt);
+        std::vector<std::string> corrupt_strings(1, "kept");
+        read(corrupt_strings_in, corrupt_strings);
+        binary_reader_t corrupt_reader(corrupt.data(), corrupt.size());
+        std::vector<double> corrupt_doubles(1, 1.5);
+        read(corrupt_reader, corrupt_doubles);
+        std::istringstream corrupt_flags_in(corrupt);
+        std::vector<bool> corrupt_flags;
+        read(corrupt_flags_in, corrupt_flags);
+        std::cout << "Comparing containers with corrupt counts: "
+            << (large == large_copy && !corrupt_strings_in && corrupt_strings.size() == 1 && corrupt_strings[0] == "kept"
+                && !corrupt_reader && corrupt_doubles.size() == 1 && corrupt_doubles[0] == 1.5
+                && !corrupt_flags_in && corrupt_flags.empty()? "Matched.":"Match Failed.") << std::endl;
+    }
+
     //remove file:
     
     std::remove(test_filename);
 }
 
 
+void run_updating_field_pool_test()
+{
+    updating_field_pool_t pool;
+
+    // a fade which settles onto its threshold fires as it does so
+    const updating_field_pool_t::handle_t fade = pool.add(0, updating_field_t::ATTENUATE, 1.0f, 0.1f);
+    pool.set_trigger(fade, 1.0f, updating_field_kernels::RISING);
+
+    // one that crosses before settling fires once only
+    const updating_field_pool_t::handle_t past = pool.add(0, updating_field_t::ATTENUATE, 2.0f, 0.1f);
+    pool.set_trigger(past, 1.0f, updating_field_kernels::RISING);
+
+    unsigned int fade_fired = 0;
+    unsigned int past_fired = 0;
+    for (unsigned int tick = 0; tick < 2000; ++tick)
+    {
+        pool.update();
+        fade_fired += std::count(pool.triggered().begin(), pool.triggered().end(), fade);
+        past_fired += std::count(pool.triggered().begin(), pool.triggered().end(), past);
+    }
+
+    std::cout << "Comparing field pool settling triggers: "
+        << (fade_fired == 1 && past_fired == 1 && pool.value(fade) == 1.0f && pool.is_sleeping(fade)? "Matched.":"Match Failed.") << std::endl;
+}
+
+void run_updating_field_history_test()
+{
+    bool restored = true;
+    for (int compressing = 0; compressing < 2; ++compressing)
+    {
+        updating_field_pool_t pool;
+        updating_field_history_t history(4, compressing != 0);
+
+        // speed drives the increment of position
+        const updating_field_pool_t::handle_t speed = pool.add(2.0f);
+        const updating_field_pool_t::handle_t position = pool.add(0.0f, updating_field_t::ADD);
+        pool.link(position, updating_field_pool_t::LINK_PARAM_A, speed);
+        pool.update();
+        history.save(pool);
+        const float saved_position = pool.value(position);
+
+        // a field added and linked after the save is gone after the restore,
+        // with its link, and the link saved with the frame is back
+        const updating_field_pool_t::handle_t spawned = pool.add(0.0f, updating_field_t::ADD);
+        pool.link(spawned, updating_field_pool_t::LINK_PARAM_A, position);
+        pool.unlink(position, updating_field_pool_t::LINK_PARAM_A);
+        pool.update();
+        history.save(pool);
+        pool.update();
+
+        restored = restored && history.restore(pool, 1) && pool.size() == 2 && pool.value(position) == saved_position;
+        pool.update();
+        restored = restored && pool.value(position) == saved_position + 2.0f;
+    }
+    std::cout << "Comparing field history restored after growth: " << (restored? "Matched.":"Match Failed.") << std::endl;
+}
+
+void run_compression_test()
+{
+    // repetitive enough to compress, with a stretch of noise which will not
+    std::string text;
+    for (unsigned int i = 0; i < 5000; ++i)
+    {
+        text += "field value ";
+        text += static_cast<char>('a' + i % 26);
+    }
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        text += static_cast<char>(random(256) - 1);
+    }
+
+    std::vector<char> compressed(compress_bound(text.size()));
+    const std::size_t compressed_size = compress_block(text.data(), text.size(), &compressed[0], compressed.size());
+    std::vector<char> decompressed(text.size());
+    std::cout << "Comparing compressed block: "
+        << (compressed_size && compressed_size < text.size()
+            && decompress_block(&compressed[0], compressed_size, &decompressed[0], decompressed.size())
+            && std::string(decompressed.begin(), decompressed.end()) == text? "Matched.":"Match Failed.") << std::endl;
+
+    // small blocks, so the frame holds both compressed and stored ones
+    std::ostringstream file;
+    {
+        compressing_ostream_t out(file, 1024);
+        out.write(text.data(), text.size());
+    }
+    std::istringstream file_in(file.str());
+    decompressing_istream_t in(file_in);
+    std::vector<char> read_back(text.size() + 1);
+    in.read(&read_back[0], read_back.size());
+    std::cout << "Comparing compressed stream: "
+        << (static_cast<std::size_t>(in.gcount()) == text.size()
+            && std::string(&read_back[0], text.size()) == text? "Matched.":"Match Failed.") << std::endl;
+
+    // a frame naming a block too large to be real ends rather than allocating it
+    std::ostringstream damaged;
+    damaged.write(file.str().data(), 4);
+    write(damaged, static_cast<uint32_t>(0xFFFFFFF0u));
+    write(damaged, static_cast<uint32_t>(100));
+    std::istringstream damaged_in(damaged.str());
+    decompressing_istream_t damaged_stream(damaged_in);
+    char c = 0;
+    damaged_stream.read(&c, 1);
+    std::cout << "Comparing oversized compressed block: " << (!damaged_stream? "Matched.":"Match Failed.") << std::endl;
+}
+
+struct save_test_context_t
+{
+    async_saver_t * saver;
+    unsigned int completions;
+};
+
+// saves again from the callback, which must not wait on the full queue
+void save_again_on_completion(void * context, const std::string & filename, const bool succeeded)
+{
+    save_test_context_t & test = *static_cast<save_test_context_t*>(context);
+    if (succeeded && test.completions++ == 0)
+    {
+        test.saver->save_copy(filename + "_again", "again", 5);
+    }
+}
+
+void run_async_save_test()
+{
+    const char test_filename[] = "stdaab_async_save_test";
+    const std::string again_filename = std::string(test_filename) + "_again";
+    std::string file_contents;
+    std::string again_contents;
+    bool saved = true;
+
+    for (int compressing = 0; compressing < 2; ++compressing)
+    {
+        async_saver_t saver(1, compressing != 0);
+        save_test_context_t context = {&saver, 0};
+
+        std::vector<char> data;
+        saver.acquire_buffer(data);
+        {
+            memory_sink_t sink(data);
+            binary_writer_t out(sink);
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                write(out, i % 7);
+            }
+            out.flush();
+        }
+        const std::string expected(data.begin(), data.end());
+        std::future<bool> result = saver.save(test_filename, data, &save_again_on_completion, &context);
+        saver.wait();
+        saved = saved && result.get() && context.completions == 1 && saver.in_flight() == 0;
+
+        file_contents.clear();
+        again_contents.clear();
+        std::ifstream file(test_filename, std::ios::binary);
+        std::ifstream again_file(again_filename.c_str(), std::ios::binary);
+        copy_file_to_string(file, file_contents);
+        copy_file_to_string(again_file, again_contents);
+        if (compressing)
+        {
+            std::istringstream compressed(file_contents);
+            decompressing_istream_t in(compressed);
+            std::vector<char> raw(expected.size() + 1);
+            in.read(&raw[0], raw.size());
+            file_contents.assign(&raw[0], static_cast<std::size_t>(in.gcount()));
+            std::istringstream compressed_again(again_contents);
+            decompressing_istream_t in_again(compressed_again);
+            in_again.read(&raw[0], raw.size());
+            again_contents.assign(&raw[0], static_cast<std::size_t>(in_again.gcount()));
+        }
+        saved = saved && file_contents == expected && again_contents == "again";
+    }
+    std::cout << "Comparing background saves: " << (saved? "Matched.":"Match Failed.") << std::endl;
+
+    std::remove(test_filename);
+    std::remove(again_filename.c_str());
+}
+
+void run_chunked_file_test()
+{
+    const uint32_t tag_a = make_chunk_tag('A', 'A', 'A', 'A');
+    const uint32_t tag_b = make_chunk_tag('B', 'B', 'B', 'B');
+
+    std::ostringstream out;
+    {
+        chunked_writer_t writer(out);
+        writer.write_chunk(tag_a, "first chunk", 11);
+        write(writer.begin_chunk(tag_b), static_cast<uint32_t>(12345));
+        writer.end_chunk();
+    }
+    const std::string file_contents = out.str();
+
+    std::vector<char> content;
+    uint32_t streamed = 0;
+    std::istringstream in(file_contents);
+    chunked_reader_t stream_reader(in);
+    const bool from_stream = stream_reader.good() && stream_reader.chunk_count() == 2
+        && stream_reader.read_chunk(tag_a, content) && std::string(content.begin(), content.end()) == "first chunk"
+        && stream_reader.seek(tag_b) && read(stream_reader.stream(), streamed) && streamed == 12345
+        && !stream_reader.has_chunk(make_chunk_tag('C', 'C', 'C', 'C'));
+    std::cout << "Comparing chunked file from stream: " << (from_stream? "Matched.":"Match Failed.") << std::endl;
+
+    chunked_reader_t memory_reader(file_contents.data(), file_contents.size());
+    const chunk_info_t * info = memory_reader.find(tag_a);
+    const bool from_memory = memory_reader.good() && info && info->size == 11
+        && std::string(memory_reader.data(*info), static_cast<std::size_t>(info->size)) == "first chunk";
+    std::cout << "Comparing chunked file from memory: " << (from_memory? "Matched.":"Match Failed.") << std::endl;
+
+    // cut short, the table of contents at the end is lost
+    chunked_reader_t truncated_reader(file_contents.data(), file_contents.size() - 4);
+    std::cout << "Comparing truncated chunked file: " << (!truncated_reader.good()? "Matched.":"Match Failed.") << std::endl;
+}
+
+void run_delta_save_test()
+{
+    const char test_filename[] = "stdaab_delta_test";
+    const uint32_t tag_a = make_chunk_tag('A', 'A', 'A', 'A');
+    const uint32_t tag_b = make_chunk_tag('B', 'B', 'B', 'B');
+    std::remove(test_filename);
+
+    std::vector<char> content;
+    std::string file_contents;
+
+    {
+        delta_save_log_t log(test_filename);
+        log.set_chunk(tag_a, "AAAA", 4);
+        log.set_chunk(tag_b, "bbbbbbbb", 8);
+        log.save();
+
+        // staged twice before saving, the second time must not look unchanged
+        log.set_chunk(tag_a, "BBBB", 4);
+        log.set_chunk(tag_a, "BBBB", 4);
+        log.save();
+    }
+    {
+        std::ifstream in(test_filename, std::ios::binary);
+        copy_file_to_string(in, file_contents);
+        chunked_reader_t reader(file_contents.data(), file_contents.size());
+        std::cout << "Comparing delta save restaged chunk: "
+            << (reader.read_chunk(tag_a, content) && std::string(content.begin(), content.end()) == "BBBB"? "Matched.":"Match Failed.") << std::endl;
+    }
+
+    {
+        // a high ratio so these saves append rather than compact
+        delta_save_log_t log(test_filename, 100.0);
+        log.open();
+        const uint64_t saved_offset = log.chunk(0).offset;
+
+        // changed then changed back before saving writes nothing new for the chunk
+        log.set_chunk(tag_a, "CCCC", 4);
+        log.set_chunk(tag_a, "BBBB", 4);
+        log.set_chunk(tag_b, "bbbbBBBB", 8);
+        log.save();
+        const bool reverted_skipped = log.chunk(0).tag == tag_a && log.chunk(0).offset == saved_offset;
+
+        log.set_chunk(tag_a, "DDDD", 4);
+        log.set_chunk(tag_a, "BBBB", 4);
+        log.save();
+
+        file_contents.clear();
+        std::ifstream in(test_filename, std::ios::binary);
+        copy_file_to_string(in, file_contents);
+        chunked_reader_t reader(file_contents.data(), file_contents.size());
+        std::vector<char> content_b;
+        std::cout << "Comparing delta save reverted chunk: "
+            << (reverted_skipped && reader.read_chunk(tag_a, content) && reader.read_chunk(tag_b, content_b)
+                && std::string(content.begin(), content.end()) == "BBBB"
+                && std::string(content_b.begin(), content_b.end()) == "bbbbBBBB"? "Matched.":"Match Failed.") << std::endl;
+    }
+
+    {
+        delta_save_log_t log(test_filename, 1.0);
+        log.open();
+        log.set_chunk(tag_b, "compacted", 9);
+        log.save();
+
+        file_contents.clear();
+        std::ifstream in(test_filename, std::ios::binary);
+        copy_file_to_string(in, file_contents);
+        chunked_reader_t reader(file_contents.data(), file_contents.size());
+        std::cout << "Comparing delta save compacted log: "
+            << (file_contents.size() == log.live_size() && reader.read_chunk(tag_b, content)
+                && std::string(content.begin(), content.end()) == "compacted"? "Matched.":"Match Failed.") << std::endl;
+    }
+
+    std::remove(test_filename);
+}
+
+void run_serial_struct_test()
+{
+    std::cout << "Comparing serial struct bulk layouts: "
+        << (serial_fields<serial_packed_t>::bulk == serial_bulk_allowed && !serial_fields<serial_padded_t>::bulk
+            && !serial_fields<serial_reordered_t>::bulk && !serial_fields<serial_nested_t>::bulk
+            && !serial_fields<serial_virtual_t>::bulk? "Matched.":"Match Failed.") << std::endl;
+
+    // the bulk path writes the same bytes as writing each field in turn
+    serial_packed_t packed[3] = {{1, 1.5f, -2.5f, 100, 7}, {-2, 0.f, 3.f, 65535, 0}, {3, -1.f, 1e6f, 1, 2}};
+    std::ostringstream bulk_out;
+    write_structs(bulk_out, packed, 3);
+    std::ostringstream fields_out;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        write(fields_out, packed[i].id);
+        write(fields_out, packed[i].x);
+        write(fields_out, packed[i].y);
+        write(fields_out, packed[i].health);
+        write(fields_out, packed[i].armour);
+    }
+    std::istringstream bulk_in(bulk_out.str());
+    serial_packed_t packed_copy[3];
+    read_structs(bulk_in, packed_copy, 3);
+    std::cout << "Comparing serial struct bulk bytes: "
+        << (bulk_out.str() == fields_out.str() && bulk_in && packed_copy[2].y == 1e6f && packed_copy[1].health == 65535? "Matched.":"Match Failed.") << std::endl;
+
+    // listed out of order, the fields are written in the listed order
+    serial_reordered_t reordered = {1.f, 2.f};
+    std::ostringstream reordered_out;
+    write_struct(reordered_out, reordered);
+    std::istringstream reordered_in(reordered_out.str());
+    float first = 0;
+    read(reordered_in, first);
+
+    serial_nested_t nested = {packed[0], "nested", -5};
+    std::ostringstream nested_out;
+    write_struct(nested_out, nested);
+    std::istringstream nested_in(nested_out.str());
+    serial_nested_t nested_copy;
+    read_struct(nested_in, nested_copy);
+    std::cout << "Comparing serial struct fields: "
+        << (first == 2.f && nested_in && nested_copy.name == "nested" && nested_copy.score == -5
+            && nested_copy.packed.x == 1.5f && nested_copy.packed.armour == 7? "Matched.":"Match Failed.") << std::endl;
+}
+
+void run_crc32c_test()
+{
+    // the standard check value, in one piece and in two
+    const char check[] = "123456789";
+    const bool known = crc32c(check, 9) == 0xE3069283u && crc32c_portable(check, 9) == 0xE3069283u
+        && crc32c(check + 4, 5, crc32c(check, 4)) == 0xE3069283u;
+    std::cout << "Comparing crc32c check value: " << (known? "Matched.":"Match Failed.") << std::endl;
+
+    // a small block size, so the streams cross several blocks
+    std::ostringstream file;
+    uint32_t written_checksum = 0;
+    {
+        checksumming_ostream_t out(file, 16);
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            write(out, i);
+        }
+        written_checksum = out.checksum();
+        write(out, written_checksum);
+    }
+    const std::string file_contents = file.str();
+
+    std::istringstream file_in(file_contents);
+    checksumming_istream_t in(file_in, 16);
+    bool values_matched = true;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        uint32_t value = 0;
+        read(in, value);
+        values_matched = values_matched && value == i;
+    }
+    const uint32_t read_checksum = in.checksum();
+    uint32_t stored = 0;
+    read(in, stored);
+    std::cout << "Comparing checksummed stream: "
+        << (values_matched && read_checksum == written_checksum && stored == written_checksum
+            && written_checksum == crc32c(file_contents.data(), 400)? "Matched.":"Match Failed.") << std::endl;
+
+    std::string damaged = file_contents;
+    damaged[123] ^= 0x10;
+    std::cout << "Comparing damaged stream checksum: "
+        << (crc32c(damaged.data(), 400) != written_checksum? "Matched.":"Match Failed.") << std::endl;
+}
+
+void run_string_table_test()
+{
+    const char * names[] = {"sword", "shield", "sword", "", "potion", "sword", "shield", ""};
+    const std::size_t name_count = sizeof(names) / sizeof(names[0]);
+
+    std::ostringstream file;
+    string_table_writer_t writer;
+    for (std::size_t n = 0; n < name_count; ++n)
+    {
+        writer.write(file, string_ref_t(names[n]));
+    }
+    const std::string file_contents = file.str();
+
+    std::istringstream in(file_contents);
+    string_table_reader_t reader;
+    bool names_matched = true;
+    string_ref_t first_sword;
+    for (std::size_t n = 0; n < name_count; ++n)
+    {
+        string_ref_t name;
+        reader.read(in, name);
+        names_matched = names_matched && name == string_ref_t(names[n]);
+        if (n == 0)
+        {
+            first_sword = name;
+        }
+        else if (n == 5)
+        {
+            // repeats refer to the one stored copy
+            names_matched = names_matched && name.data() == first_sword.data();
+        }
+    }
+    std::cout << "Comparing string table: "
+        << (names_matched && in && reader.good() && writer.size() == 4 && reader.size() == 4? "Matched.":"Match Failed.") << std::endl;
+
+    // an index to a string not yet read
+    std::ostringstream bad_file;
+    write_varint(bad_file, 3);
+    std::istringstream bad_in(bad_file.str());
+    string_table_reader_t bad_reader;
+    std::string name = "unchanged";
+    bad_reader.read(bad_in, name);
+    std::cout << "Comparing bad string table index: " << (!bad_reader.good() && name.empty()? "Matched.":"Match Failed.") << std::endl;
+
+    // a string longer than one read piece, then a length far beyond the data
+    const std::string long_name(200000, 'x');
+    std::ostringstream long_file;
+    string_table_writer_t long_writer;
+    long_writer.write(long_file, string_ref_t(long_name.data(), long_name.size()));
+    write_varint(long_file, 0);
+    write_varint(long_file, 0xFFFFFFFFu);
+    std::istringstream long_in(long_file.str());
+    string_table_reader_t long_reader;
+    std::string long_copy;
+    std::string cut_copy = "unchanged";
+    long_reader.read(long_in, long_copy);
+    long_reader.read(long_in, cut_copy);
+    std::cout << "Comparing long and cut short table strings: "
+        << (long_copy == long_name && !long_in && cut_copy.empty() && long_reader.size() == 1? "Matched.":"Match Failed.") << std::endl;
+}
+
+void run_string_conversion_test()
+{
+    // integers at their limits, with surrounding whitespace and signs
+    const bool integers = to_string(std::numeric_limits<int>::min()) == "-2147483648"
+        && from_string<int>(" -2147483648\n") == std::numeric_limits<int>::min()
+        && from_string<unsigned int>("+4294967295") == std::numeric_limits<unsigned int>::max()
+        && from_string_no_throw<unsigned int>("4294967296", 7) == 7
+        && from_string_no_throw<int>("4 2", 7) == 7;
+    std::cout << "Comparing integer conversion: " << (integers? "Matched.":"Match Failed.") << std::endl;
+
+    // the shortest text which reads back, the same with or without to_chars
+    const bool shortest = to_string(0.1) == "0.1" && to_string(0.1f) == "0.1"
+        && to_string(5e-324) == "5e-324" && to_string(123456789.0f) == "123456792"
+        && to_string(1e22) == "1e+22" && to_string(-0.0) == "-0";
+    std::cout << "Comparing shortest float text: " << (shortest? "Matched.":"Match Failed.") << std::endl;
+
+    bool round_trip = true;
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        const double d = (random(2000000) - 1000000) / static_cast<double>(random(1000));
+        const float f = static_cast<float>(d);
+        round_trip = round_trip && from_string<double>(to_string(d)) == d && from_string<float>(to_string(f)) == f;
+    }
+    const double infinity = std::numeric_limits<double>::infinity();
+    round_trip = round_trip && from_string<double>(to_string(-infinity)) == -infinity;
+    std::cout << "Comparing float round trip: " << (round_trip? "Matched.":"Match Failed.") << std::endl;
+
+    // hex, nan(...) and out of range values fail whichever way floats are parsed
+    const bool rejected = from_string_no_throw<double>("0x10", 7) == 7
+        && from_string_no_throw<double>("1e-400", 7) == 7
+        && from_string_no_throw<double>("1e400", 7) == 7
+        && from_string_no_throw<float>("1e-46", 7) == 7
+        && from_string_no_throw<double>("nan(1)", 7) == 7
+        && from_string_no_throw<double>("1e", 7) == 7
+        && from_string<double>(" .5 ") == 0.5 && from_string<float>("+2.5E1") == 25.0f;
+    std::cout << "Comparing float text rejected: " << (rejected? "Matched.":"Match Failed.") << std::endl;
+
+    // types left to string streams fail on empty text too
+    bool stream_empty_threw = false;
+    try
+    {
+        from_string<long double>("");
+    }
+    catch (conversion_error&)
+    {
+        stream_empty_threw = true;
+    }
+    std::cout << "Comparing stream conversion of empty text: "
+        << (stream_empty_threw && from_string_no_throw<bool>("", true) && from_string<long double>(" 2.5 ") == 2.5L? "Matched.":"Match Failed.") << std::endl;
+}
+
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,6 +1043,16 @@ bool randomMinN (int m, int n)
 int main(int argc, char*argv[])
 {
     game_dev_utilities::run_test();
+    game_dev_utilities::run_updating_field_pool_test();
+    game_dev_utilities::run_updating_field_history_test();
+    game_dev_utilities::run_compression_test();
+    game_dev_utilities::run_async_save_test();
+    game_dev_utilities::run_chunked_file_test();
+    game_dev_utilities::run_delta_save_test();
+    game_dev_utilities::run_serial_struct_test();
+    game_dev_utilities::run_crc32c_test();
+    game_dev_utilities::run_string_table_test();
+    game_dev_utilities::run_string_conversion_test();
     
     return 0;
 }
@@ -0,0 +1,125 @@
+/*
+*
+*    aligned_allocator.hpp - an allocator for standard containers which places
+*    their storage on a chosen alignment, such as a cache line
+*
+*    Used by the updating field pools so that work split across threads never
+*    shares a cache line between two workers.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_ALIGNED_ALLOCATOR_HPP
+#define GAME_DEV_UTILITIES_ALIGNED_ALLOCATOR_HPP
+#include<cstddef>
+#include<new>
+namespace game_dev_utilities
+{
+
+static const std::size_t cache_line_size = 64;
+
+// Alignment must be a power of two. The offset to the original allocation is
+// stored in the bytes just before the aligned block.
+template<typename T, const std::size_t Alignment = cache_line_size>
+struct aligned_allocator
+{
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind
+    {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+
+    aligned_allocator()
+    {
+        // do nothing //
+    }
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&)
+    {
+        // do nothing //
+    }
+
+    T* allocate(const std::size_t count)
+    {
+        const std::size_t padding = Alignment + sizeof(std::size_t);
+        char * raw = static_cast<char*>(::operator new(count * sizeof(T) + padding));
+
+        const std::size_t address = reinterpret_cast<std::size_t>(raw + sizeof(std::size_t));
+        char * aligned = raw + sizeof(std::size_t) + ((Alignment - address % Alignment) % Alignment);
+
+        reinterpret_cast<std::size_t*>(aligned)[-1] = aligned - raw;
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    void deallocate(T * block, const std::size_t)
+    {
+        if (block)
+        {
+            char * aligned = reinterpret_cast<char*>(block);
+            ::operator delete(aligned - reinterpret_cast<std::size_t*>(aligned)[-1]);
+        }
+    }
+
+    std::size_t max_size() const
+    {
+        return (static_cast<std::size_t>(-1) - Alignment) / sizeof(T);
+    }
+
+    void construct(T * p, const T& value)
+    {
+        new (p) T(value);
+    }
+
+    void destroy(T * p)
+    {
+        p->~T();
+    }
+
+    bool operator == (const aligned_allocator&) const
+    {
+        return true;
+    }
+
+    bool operator != (const aligned_allocator&) const
+    {
+        return false;
+    }
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_ALIGNED_ALLOCATOR_HPP
@@ -0,0 +1,215 @@
+/*
+*
+*    async_save.cpp - saving files on a background thread
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include"async_save.hpp"
+#include"binary_io.hpp"
+#include"compression.hpp"
+#include<cstdio>
+#include<utility>
+namespace game_dev_utilities
+{
+
+
+async_saver_t::async_saver_t(const std::size_t max_in_flight_in, const bool compress_in):
+    max_in_flight(max_in_flight_in ? max_in_flight_in : 1),
+    compress(compress_in),
+    completing(false),
+    stopping(false)
+{
+    worker = std::thread(&async_saver_t::work_loop, this);
+}
+
+async_saver_t::~async_saver_t()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_queued.notify_all();
+    worker.join();
+}
+
+bool async_saver_t::write_file(const std::string & filename, const char * data, const std::size_t size, const bool compress)
+{
+    const std::string temporary = filename + ".tmp";
+    std::FILE * file = std::fopen(temporary.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    bool succeeded;
+    {
+        file_sink_t sink(file);
+        binary_writer_t out(sink);
+
+        if (compress)
+        {
+            write_compressed_frame(out, data, size);
+        }
+        else
+        {
+            out.write(data, size);
+        }
+        succeeded = out.flush();
+    }
+
+    succeeded = flush_to_disk(file) && succeeded;
+    succeeded = std::fclose(file) == 0 && succeeded;
+
+    if (!succeeded || !replace_file(temporary, filename))
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+void async_saver_t::work_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;)
+    {
+        while (jobs.empty() && !stopping)
+        {
+            job_queued.wait(lock);
+        }
+        if (jobs.empty())
+        {
+            return; // stopping, with nothing left to save
+        }
+
+        job_t * job = jobs.front().get();
+        lock.unlock();
+
+        const bool succeeded = write_file(job->filename, job->data.empty() ? 0 : &job->data[0], job->data.size(), compress);
+
+        // off the queue before the callback, which may queue another save
+        lock.lock();
+        std::unique_ptr<job_t> finished(std::move(jobs.front()));
+        jobs.pop_front();
+        if (spare_buffers.size() <= max_in_flight)
+        {
+            finished->data.clear();
+            spare_buffers.push_back(std::vector<char>());
+            spare_buffers.back().swap(finished->data);
+        }
+        completing = true;
+        lock.unlock();
+        job_finished.notify_all();
+
+        if (finished->completion)
+        {
+            finished->completion(finished->context, finished->filename, succeeded);
+        }
+        finished->result.set_value(succeeded);
+
+        lock.lock();
+        completing = false;
+        job_finished.notify_all();
+    }
+}
+
+std::future<bool> async_saver_t::save(const std::string & filename, std::vector<char> & data,
+    completion_function_t completion, void * context)
+{
+    return queue_save(filename, data, completion, context, true);
+}
+
+std::future<bool> async_saver_t::save_copy(const std::string & filename, const char * data, const std::size_t size,
+    completion_function_t completion, void * context)
+{
+    std::vector<char> buffer;
+    acquire_buffer(buffer);
+    buffer.assign(data, data + size);
+    return queue_save(filename, buffer, completion, context, false);
+}
+
+std::future<bool> async_saver_t::queue_save(const std::string & filename, std::vector<char> & data,
+    completion_function_t completion, void * context, const bool hand_back_spare)
+{
+    std::unique_ptr<job_t> job(new job_t);
+    job->filename = filename;
+    job->completion = completion;
+    job->context = context;
+    job->data.swap(data);
+    std::future<bool> result = job->result.get_future();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        // a completion callback saving again must not wait on its own thread
+        const bool on_worker = std::this_thread::get_id() == worker.get_id();
+        while (jobs.size() >= max_in_flight && !on_worker)
+        {
+            job_finished.wait(lock);
+        }
+
+        jobs.push_back(std::move(job));
+        if (hand_back_spare && !spare_buffers.empty())
+        {
+            data.swap(spare_buffers.back());
+            spare_buffers.pop_back();
+        }
+    }
+    job_queued.notify_one();
+
+    return result;
+}
+
+void async_saver_t::acquire_buffer(std::vector<char> & buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!spare_buffers.empty())
+    {
+        buffer.swap(spare_buffers.back());
+        spare_buffers.pop_back();
+    }
+    buffer.clear();
+}
+
+std::size_t async_saver_t::in_flight() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+void async_saver_t::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!jobs.empty() || completing)
+    {
+        job_finished.wait(lock);
+    }
+}
+
+
+}
@@ -0,0 +1,135 @@
+/*
+*
+*    async_save.hpp - saving files on a background thread
+*
+*    The game thread serializes into a std::vector<char>, for instance with a
+*    binary_writer_t over a memory_sink_t, and hands the buffer over with
+*    save(). Buffers are swapped rather than copied, and the caller is handed
+*    back a spare buffer from an earlier save, so in the steady state saving
+*    allocates nothing and costs the game thread no file I/O at all.
+*
+*    The background thread optionally compresses the data (see compression.hpp),
+*    writes it to a temporary file, flushes it to disk and then renames it over
+*    the destination, flushing the directory too where the system needs it, so
+*    a crash mid save never leaves a half written file.
+*
+*    Requires the C++11 thread library, as worker_pool.hpp does.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_ASYNC_SAVE_HPP
+#define GAME_DEV_UTILITIES_ASYNC_SAVE_HPP
+#include<cstddef>
+#include<string>
+#include<vector>
+#include<deque>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<future>
+#include<memory>
+namespace game_dev_utilities
+{
+
+class async_saver_t
+{
+    public:
+
+        // Called on the background thread once a save has finished and left
+        // the queue. It may call save() but not wait(), which waits for it.
+        typedef void (*completion_function_t)(void * context, const std::string & filename, const bool succeeded);
+
+        // save() waits while max_in_flight saves are queued or being written
+        explicit async_saver_t(const std::size_t max_in_flight = 2, const bool compress = false);
+
+        // finishes every queued save before returning
+        ~async_saver_t();
+
+        /*
+        *   Queues data to be written to filename, and swaps data with a spare
+        *   buffer (cleared, but with its capacity kept) for the next save. The
+        *   future becomes true once the file is safely on disk.
+        */
+        std::future<bool> save(const std::string & filename, std::vector<char> & data,
+            completion_function_t completion = 0, void * context = 0);
+
+        // as save(), copying the data into a spare buffer first
+        std::future<bool> save_copy(const std::string & filename, const char * data, const std::size_t size,
+            completion_function_t completion = 0, void * context = 0);
+
+        // swaps buffer with a spare one, if there is one, to serialize into
+        void acquire_buffer(std::vector<char> & buffer);
+
+        // saves queued or being written
+        std::size_t in_flight() const;
+
+        // blocks until every queued save has finished
+        void wait();
+
+        // writes data to filename as the background thread does, on this thread
+        static bool write_file(const std::string & filename, const char * data, const std::size_t size, const bool compress);
+
+    private:
+
+        struct job_t
+        {
+            std::string filename;
+            std::vector<char> data;
+            std::promise<bool> result;
+            completion_function_t completion;
+            void * context;
+        };
+
+        void work_loop();
+
+        // hand_back_spare swaps a spare buffer into data, for save()
+        std::future<bool> queue_save(const std::string & filename, std::vector<char> & data,
+            completion_function_t completion, void * context, const bool hand_back_spare);
+
+        async_saver_t(const async_saver_t&);
+        async_saver_t& operator = (const async_saver_t&);
+
+        mutable std::mutex mutex;
+        std::condition_variable job_queued;
+        std::condition_variable job_finished;
+
+        std::deque<std::unique_ptr<job_t> > jobs;    // the front job is the one being written
+        std::vector<std::vector<char> > spare_buffers;
+        std::size_t max_in_flight;
+        bool compress;
+        bool completing;    // a finished job's callback is running
+        bool stopping;
+
+        std::thread worker;
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_ASYNC_SAVE_HPP
@@ -0,0 +1,271 @@
+/*
+*
+*    binary_io.cpp - buffered binary writing and reading
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"binary_io.hpp"
+#include"bit_packing.hpp"
+#include<algorithm>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX // std::min and std::max are used below
+#endif
+#include<windows.h>
+#include<io.h>
+#else
+#include<fcntl.h>
+#include<unistd.h>
+#endif
+namespace game_dev_utilities
+{
+
+////////////////////////////////////////////////////////////////////////////////
+//  Sinks and sources
+////////////////////////////////////////////////////////////////////////////////
+
+bool file_sink_t::write(const char * data, const std::size_t size)
+{
+    return std::fwrite(data, 1, size, file) == size;
+}
+
+std::size_t file_source_t::read(char * data, const std::size_t size)
+{
+    return std::fread(data, 1, size, file);
+}
+
+bool descriptor_sink_t::write(const char * data, const std::size_t size)
+{
+    std::size_t written = 0;
+
+    while (written < size)
+    {
+#ifdef _WIN32
+        const int result = ::_write(descriptor, data + written, static_cast<unsigned int>(size - written));
+#else
+        const ssize_t result = ::write(descriptor, data + written, size - written);
+#endif
+        if (result <= 0)
+        {
+            return false;
+        }
+        written += result;
+    }
+
+    return true;
+}
+
+std::size_t descriptor_source_t::read(char * data, const std::size_t size)
+{
+    std::size_t total = 0;
+
+    while (total < size)
+    {
+#ifdef _WIN32
+        const int result = ::_read(descriptor, data + total, static_cast<unsigned int>(size - total));
+#else
+        const ssize_t result = ::read(descriptor, data + total, size - total);
+#endif
+        if (result <= 0)
+        {
+            break;
+        }
+        total += result;
+    }
+
+    return total;
+}
+
+bool flush_to_disk(std::FILE * file)
+{
+    if (std::fflush(file) != 0)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return ::fsync(fileno(file)) == 0;
+#endif
+}
+
+#ifndef _WIN32
+namespace
+{
+
+bool flush_directory_to_disk(const std::string & filename)
+{
+    const std::string::size_type slash = filename.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : filename.substr(0, slash);
+
+    const int descriptor = ::open(directory.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return false;
+    }
+    const bool succeeded = ::fsync(descriptor) == 0;
+    return ::close(descriptor) == 0 && succeeded;
+}
+
+} // namespace
+#endif
+
+bool replace_file(const std::string & from, const std::string & to)
+{
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0 && flush_directory_to_disk(to);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Writer
+////////////////////////////////////////////////////////////////////////////////
+
+binary_writer_t::binary_writer_t(binary_sink_t & sink_in, const std::size_t buffer_size)
+:   sink(sink_in),
+    buffer(std::max<std::size_t>(buffer_size, 1)),
+    position(&buffer[0]),
+    end(&buffer[0] + buffer.size()),
+    failed(false)
+{
+    // do nothing //
+}
+
+binary_writer_t::~binary_writer_t()
+{
+    flush();
+}
+
+bool binary_writer_t::flush()
+{
+    const std::size_t size = position - &buffer[0];
+    position = &buffer[0];
+
+    if (size && !failed)
+    {
+        failed = !sink.write(&buffer[0], size);
+    }
+
+    return !failed;
+}
+
+// called when the data does not fit in what is left of the buffer
+void binary_writer_t::write_slow(const char * data, const std::size_t size)
+{
+    if (!flush())
+    {
+        return;
+    }
+
+    if (size >= buffer.size())
+    {
+        failed = !sink.write(data, size);
+    }
+    else
+    {
+        std::memcpy(position, data, size);
+        position += size;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reader
+////////////////////////////////////////////////////////////////////////////////
+
+binary_reader_t::binary_reader_t(binary_source_t & source_in, const std::size_t buffer_size)
+:   source(&source_in),
+    buffer(std::max<std::size_t>(buffer_size, 1)),
+    position(&buffer[0]),
+    end(&buffer[0]),
+    failed(false)
+{
+    // do nothing //
+}
+
+binary_reader_t::binary_reader_t(const char * data, const std::size_t size)
+:   source(0),
+    position(data),
+    end(data + size),
+    failed(false)
+{
+    // do nothing //
+}
+
+// called when the buffer holds less than was asked for
+void binary_reader_t::read_slow(char * data, const std::size_t size)
+{
+    std::size_t available = end - position;
+    std::memcpy(data, position, available);
+    position = end;
+
+    if (source && !failed)
+    {
+        if (size - available >= buffer.size())
+        {
+            available += source->read(data + available, size - available);
+        }
+        else
+        {
+            const std::size_t refill = source->read(&buffer[0], buffer.size());
+            const std::size_t copied = std::min(refill, size - available);
+
+            std::memcpy(data + available, &buffer[0], copied);
+            available += copied;
+            position = &buffer[0] + copied;
+            end = &buffer[0] + refill;
+        }
+    }
+
+    if (available < size)
+    {
+        std::memset(data + available, 0, size - available);
+        failed = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Bools, packed as in io.cpp with the first value in the lowest bit
+////////////////////////////////////////////////////////////////////////////////
+
+binary_reader_t& read(binary_reader_t& in, bool* values, const size_t count)
+{
+    return read_packed_bools(in, values, count);
+}
+
+binary_writer_t& write(binary_writer_t& out, const bool* values, const size_t count)
+{
+    return write_packed_bools(out, values, count);
+}
+
+
+}
@@ -0,0 +1,553 @@
+/*
+*
+*    binary_io.hpp - buffered binary writing and reading, with the same read
+*    and write overloads as io.hpp
+*
+*    Each read or write through io.hpp is a call on a std::stream for a single
+*    value. binary_writer_t and binary_reader_t instead copy values into a
+*    contiguous buffer of their own with an inline bounds check, and only pass
+*    data to the underlying file, descriptor or memory in large blocks.
+*
+*    Code written against the io.hpp overloads works unchanged with either
+*    class in place of the stream, and produces the same bytes.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_BINARY_IO_HPP
+#define GAME_DEV_UTILITIES_BINARY_IO_HPP
+#include<cstdio>
+#include<cstring>
+#include<string>
+#include<vector>
+#include<iostream>
+#include<stdint.h>
+#include"byte_order.hpp"
+#include"container_io.hpp"
+namespace game_dev_utilities
+{
+
+////////////////////////////////////////////////////////////////////////////////
+//  Sinks and sources - where the blocks go to and come from
+////////////////////////////////////////////////////////////////////////////////
+
+class binary_sink_t
+{
+    public:
+
+    virtual ~binary_sink_t()
+    {
+        // do nothing //
+    }
+
+    // returns false if the data could not all be written
+    virtual bool write(const char * data, const std::size_t size) = 0;
+};
+
+class binary_source_t
+{
+    public:
+
+    virtual ~binary_source_t()
+    {
+        // do nothing //
+    }
+
+    // returns the number of bytes read, fewer than size only at the end
+    virtual std::size_t read(char * data, const std::size_t size) = 0;
+};
+
+class file_sink_t : public binary_sink_t
+{
+    std::FILE * file;
+
+    public:
+
+    explicit file_sink_t(std::FILE * file_in) : file(file_in)
+    {
+        // do nothing //
+    }
+
+    virtual bool write(const char * data, const std::size_t size);
+};
+
+class file_source_t : public binary_source_t
+{
+    std::FILE * file;
+
+    public:
+
+    explicit file_source_t(std::FILE * file_in) : file(file_in)
+    {
+        // do nothing //
+    }
+
+    virtual std::size_t read(char * data, const std::size_t size);
+};
+
+// a file descriptor as given by open()
+class descriptor_sink_t : public binary_sink_t
+{
+    int descriptor;
+
+    public:
+
+    explicit descriptor_sink_t(const int descriptor_in) : descriptor(descriptor_in)
+    {
+        // do nothing //
+    }
+
+    virtual bool write(const char * data, const std::size_t size);
+};
+
+class descriptor_source_t : public binary_source_t
+{
+    int descriptor;
+
+    public:
+
+    explicit descriptor_source_t(const int descriptor_in) : descriptor(descriptor_in)
+    {
+        // do nothing //
+    }
+
+    virtual std::size_t read(char * data, const std::size_t size);
+};
+
+// appends to a vector
+class memory_sink_t : public binary_sink_t
+{
+    std::vector<char> & memory;
+
+    public:
+
+    explicit memory_sink_t(std::vector<char> & memory_in) : memory(memory_in)
+    {
+        // do nothing //
+    }
+
+    virtual bool write(const char * data, const std::size_t size)
+    {
+        memory.insert(memory.end(), data, data + size);
+        return true;
+    }
+};
+
+class ostream_sink_t : public binary_sink_t
+{
+    std::ostream & out;
+
+    public:
+
+    explicit ostream_sink_t(std::ostream & out_in) : out(out_in)
+    {
+        // do nothing //
+    }
+
+    virtual bool write(const char * data, const std::size_t size)
+    {
+        return static_cast<bool>(out.write(data, size));
+    }
+};
+
+class istream_source_t : public binary_source_t
+{
+    std::istream & in;
+
+    public:
+
+    explicit istream_source_t(std::istream & in_in) : in(in_in)
+    {
+        // do nothing //
+    }
+
+    virtual std::size_t read(char * data, const std::size_t size)
+    {
+        in.read(data, size);
+        return static_cast<std::size_t>(in.gcount());
+    }
+};
+
+// flushes a file's buffered data and then the system's cache, so it is on disk
+bool flush_to_disk(std::FILE * file);
+
+// renames from over to as one step; on POSIX the directory holding to is then
+// flushed as well, as the rename is only on disk once the directory is
+bool replace_file(const std::string & from, const std::string & to);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Writer
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+*   Like a stream, a writer that fails stays failed and further writes are
+*   ignored; check it with good() or as a bool. The buffer is flushed when full,
+*   on flush() and on destruction.
+*/
+class binary_writer_t
+{
+    binary_sink_t & sink;
+    std::vector<char> buffer;
+    char * position;
+    char * end;
+    bool failed;
+
+    void write_slow(const char * data, const std::size_t size);
+
+    binary_writer_t(const binary_writer_t&);
+    binary_writer_t& operator = (const binary_writer_t&);
+
+    public:
+
+    static const std::size_t default_buffer_size = 64 * 1024;
+
+    explicit binary_writer_t(binary_sink_t & sink_in, const std::size_t buffer_size = default_buffer_size);
+    ~binary_writer_t();
+
+    // data may be null when size is 0, as for an empty chunk; memcpy takes no null
+    binary_writer_t & write(const char * data, const std::size_t size)
+    {
+        if (size <= static_cast<std::size_t>(end - position))
+        {
+            if (size)
+            {
+                std::memcpy(position, data, size);
+                position += size;
+            }
+        }
+        else
+        {
+            write_slow(data, size);
+        }
+        return *this;
+    }
+
+    // passes everything buffered to the sink
+    bool flush();
+
+    bool good() const
+    {
+        return !failed;
+    }
+
+    operator bool() const
+    {
+        return !failed;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reader
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+*   Reads through a buffer refilled from the source in large blocks, or
+*   directly from a block of memory with no copying into a buffer at all.
+*   Reading past the end fails the reader, as with a stream, and zero fills
+*   what could not be read.
+*/
+class binary_reader_t
+{
+    binary_source_t * source;
+    std::vector<char> buffer;
+    const char * position;
+    const char * end;
+    bool failed;
+
+    void read_slow(char * data, const std::size_t size);
+
+    binary_reader_t(const binary_reader_t&);
+    binary_reader_t& operator = (const binary_reader_t&);
+
+    public:
+
+    static const std::size_t default_buffer_size = 64 * 1024;
+
+    explicit binary_reader_t(binary_source_t & source_in, const std::size_t buffer_size = default_buffer_size);
+
+    // reads from memory, which must outlive the reader
+    binary_reader_t(const char * data, const std::size_t size);
+
+    binary_reader_t & read(char * data, const std::size_t size)
+    {
+        if (size <= static_cast<std::size_t>(end - position))
+        {
+            if (size)
+            {
+                std::memcpy(data, position, size);
+                position += size;
+            }
+        }
+        else
+        {
+            read_slow(data, size);
+        }
+        return *this;
+    }
+
+    // the next size bytes in place, for readers over memory; any other reader,
+    // or one with too few bytes left, fails and returns 0
+    const char * view(const std::size_t size)
+    {
+        if (source || failed || size > static_cast<std::size_t>(end - position))
+        {
+            failed = true;
+            position = end;
+            return 0;
+        }
+        const char * viewed = position;
+        position += size;
+        return viewed;
+    }
+
+    // bytes left in the buffer, or in the memory being read
+    std::size_t buffered() const
+    {
+        return end - position;
+    }
+
+    // the buffered bytes themselves, for decoders which parse them in place
+    // and then consume() what they used
+    const char * buffered_data() const
+    {
+        return position;
+    }
+
+    void consume(const std::size_t size)
+    {
+        position += size < buffered()? size : buffered();
+    }
+
+    bool good() const
+    {
+        return !failed;
+    }
+
+    operator bool() const
+    {
+        return !failed;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read and write overloads, matching io.hpp
+////////////////////////////////////////////////////////////////////////////////
+
+#define GAME_DEV_UTILITIES_BINARY_IO_TYPE(TYPE, SUFFIX) \
+    inline binary_reader_t& read(binary_reader_t& in, TYPE&value) \
+    { \
+        return read_little_endian(in, &value, 1); \
+    } \
+    inline binary_reader_t& read##SUFFIX(binary_reader_t& in, TYPE&value) \
+    { \
+        return read_little_endian(in, &value, 1); \
+    } \
+    inline binary_reader_t& read(binary_reader_t& in, TYPE* values, const size_t count) \
+    { \
+        return read_little_endian(in, values, count); \
+    } \
+    inline binary_reader_t& read##SUFFIX(binary_reader_t& in, TYPE* values, const size_t count) \
+    { \
+        return read_little_endian(in, values, count); \
+    } \
+    inline binary_writer_t& write(binary_writer_t& out, const TYPE&value) \
+    { \
+        return write_little_endian(out, &value, 1); \
+    } \
+    inline binary_writer_t& write##SUFFIX(binary_writer_t& out, const TYPE&value) \
+    { \
+        return write_little_endian(out, &value, 1); \
+    } \
+    inline binary_writer_t& write(binary_writer_t& out, const TYPE* values, const size_t count) \
+    { \
+        return write_little_endian(out, values, count); \
+    } \
+    inline binary_writer_t& write##SUFFIX(binary_writer_t& out, const TYPE* values, const size_t count) \
+    { \
+        return write_little_endian(out, values, count); \
+    }
+
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(int64_t, _s64)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(int32_t, _s32)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(int16_t, _s16)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(int8_t, _s8)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(uint64_t, _u64)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(uint32_t, _u32)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(uint16_t, _u16)
+GAME_DEV_UTILITIES_BINARY_IO_TYPE(uint8_t, _u8)
+
+#undef GAME_DEV_UTILITIES_BINARY_IO_TYPE
+
+inline binary_reader_t& read(binary_reader_t& in, float&value)
+{
+    return read_little_endian(in, &value, 1);
+}
+inline binary_reader_t& read(binary_reader_t& in, float* values, const size_t count)
+{
+    return read_little_endian(in, values, count);
+}
+inline binary_writer_t& write(binary_writer_t& out, const float&value)
+{
+    return write_little_endian(out, &value, 1);
+}
+inline binary_writer_t& write(binary_writer_t& out, const float* values, const size_t count)
+{
+    return write_little_endian(out, values, count);
+}
+
+inline binary_reader_t& read(binary_reader_t& in, double&value)
+{
+    return read_little_endian(in, &value, 1);
+}
+inline binary_reader_t& read(binary_reader_t& in, double* values, const size_t count)
+{
+    return read_little_endian(in, values, count);
+}
+inline binary_writer_t& write(binary_writer_t& out, const double&value)
+{
+    return write_little_endian(out, &value, 1);
+}
+inline binary_writer_t& write(binary_writer_t& out, const double* values, const size_t count)
+{
+    return write_little_endian(out, values, count);
+}
+
+inline binary_reader_t& read_d(binary_reader_t& in, double&value)
+{
+    return read_little_endian(in, &value, 1);
+}
+inline binary_reader_t& read_d(binary_reader_t& in, double* values, const size_t count)
+{
+    return read_little_endian(in, values, count);
+}
+inline binary_writer_t& write_d(binary_writer_t& out, const double&value)
+{
+    return write_little_endian(out, &value, 1);
+}
+inline binary_writer_t& write_d(binary_writer_t& out, const double* values, const size_t count)
+{
+    return write_little_endian(out, values, count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Sized strings, max size 65535 chars
+//////////////////////////////////////////////////////////////////////////////// 
+
+// caller must delete allocated string with delete[]
+inline binary_reader_t& read_alloc(binary_reader_t& in, char ** str)
+{
+    uint16_t size = 0;
+    read(in, size);
+    *str = new char [size];
+    return in.read(*str, size);
+}
+
+inline binary_reader_t& read(binary_reader_t& in, std::string &str)
+{
+    uint16_t size = 0;
+    read(in, size);
+    str.assign(size, ' ');
+    return size ? in.read(&str[0], size) : in;
+}
+
+inline binary_writer_t& write(binary_writer_t& out, const char * str, const uint16_t size)
+{
+    write(out, size);
+    return out.write(str, size);
+}
+
+inline binary_writer_t& write(binary_writer_t& out, const std::string& str)
+{
+    const uint16_t size = static_cast<uint16_t>(str.size());
+    write(out, size);
+    return out.write(str.c_str(), size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Bools, one byte each or packed eight to a byte in arrays
+//////////////////////////////////////////////////////////////////////////////// 
+
+inline binary_reader_t& read(binary_reader_t& in, bool&value)
+{
+    uint8_t buff = 0;
+    read(in, buff);
+    value = buff;
+    return in;
+}
+inline binary_reader_t& read_b(binary_reader_t& in, bool&value)
+{
+    return read(in, value);
+}
+
+inline binary_writer_t& write(binary_writer_t& out, const bool&value)
+{
+    const uint8_t buff = value;
+    return write(out, buff);
+}
+inline binary_writer_t& write_b(binary_writer_t& out, const bool&value)
+{
+    return write(out, value);
+}
+
+binary_reader_t& read(binary_reader_t& in, bool* values, const size_t count);
+inline binary_reader_t& read_b(binary_reader_t& in, bool* values, const size_t count)
+{
+    return read(in, values, count);
+}
+
+binary_writer_t& write(binary_writer_t& out, const bool* values, const size_t count);
+inline binary_writer_t& write_b(binary_writer_t& out, const bool* values, const size_t count)
+{
+    return write(out, values, count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Containers, in the layout described in container_io.hpp
+//////////////////////////////////////////////////////////////////////////////// 
+
+template<typename C>
+inline binary_reader_t& read(binary_reader_t& in, C & container)
+{
+    container_io<C>::read_from(in, container);
+    return in;
+}
+
+template<typename C>
+inline binary_writer_t& write(binary_writer_t& out, const C & container)
+{
+    container_io<C>::write_to(out, container);
+    return out;
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_BINARY_IO_HPP
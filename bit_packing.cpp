@@ -0,0 +1,196 @@
+/*
+*
+*    bit_packing.cpp - packing bools and n bit integers
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"bit_packing.hpp"
+#include"byte_order.hpp"
+#include<cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#ifndef GAME_DEV_UTILITIES_SSE2
+#define GAME_DEV_UTILITIES_SSE2
+#endif
+#include<emmintrin.h>
+#endif
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+inline uint64_t load_little_endian(const uint8_t * bytes)
+{
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    little_endian_to_host(&word, 1, sizeof(word));
+    return word;
+}
+
+} // namespace
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Bools
+////////////////////////////////////////////////////////////////////////////////
+
+void pack_bools(const bool * values, const std::size_t count, uint8_t * bytes)
+{
+    std::size_t v = 0;
+
+    #ifdef GAME_DEV_UTILITIES_SSE2
+    // a byte mask of the sixteen values which are false, inverted
+    const __m128i zero = _mm_setzero_si128();
+    for (; v + 16 <= count; v += 16, bytes += 2)
+    {
+        const __m128i flags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + v));
+        const unsigned int mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(flags, zero));
+        bytes[0] = static_cast<uint8_t>(mask);
+        bytes[1] = static_cast<uint8_t>(mask >> 8);
+    }
+    #endif
+
+    // eight at a time, multiplying each byte's low bit up into the top byte
+    for (; v + 8 <= count; v += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, values + v, 8);
+        host_to_little_endian(&word, 1, 8);
+        *bytes++ = static_cast<uint8_t>(((word & 0x0101010101010101ULL) * 0x0102040810204080ULL) >> 56);
+    }
+
+    if (v < count)
+    {
+        uint8_t last = 0;
+        for (unsigned int b = 0; v < count; ++v, ++b)
+        {
+            last |= static_cast<uint8_t>(values[v] != 0) << b;
+        }
+        *bytes = last;
+    }
+}
+
+void unpack_bools(const uint8_t * bytes, const std::size_t count, bool * values)
+{
+    std::size_t v = 0;
+
+    #ifdef GAME_DEV_UTILITIES_SSE2
+    // each byte spread across eight lanes, each lane tested against its own bit
+    const __m128i bit_of_lane = _mm_set_epi8(
+        -128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    const __m128i one = _mm_set1_epi8(1);
+    for (; v + 16 <= count; v += 16, bytes += 2)
+    {
+        __m128i spread = _mm_cvtsi32_si128(bytes[0] | (bytes[1] << 8));
+        spread = _mm_unpacklo_epi8(spread, spread);
+        spread = _mm_unpacklo_epi16(spread, spread);
+        spread = _mm_unpacklo_epi32(spread, spread);
+
+        const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(spread, bit_of_lane), bit_of_lane);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + v), _mm_and_si128(set, one));
+    }
+    #endif
+
+    // eight at a time: broadcast the byte, keep bit i in byte i, then carry
+    // any set bit up to the top of its byte
+    for (; v + 8 <= count; v += 8)
+    {
+        uint64_t word = (*bytes++ * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+        word = ((word + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+        host_to_little_endian(&word, 1, 8);
+        std::memcpy(values + v, &word, 8);
+    }
+
+    for (unsigned int b = 0; v < count; ++v, ++b)
+    {
+        values[v] = (*bytes >> b) & 1;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  N bit integers
+////////////////////////////////////////////////////////////////////////////////
+
+void pack_bits(const uint32_t * values, const std::size_t count, const unsigned int bits, uint8_t * bytes)
+{
+    const uint64_t mask = bits >= 32? 0xFFFFFFFFULL : (static_cast<uint64_t>(1) << bits) - 1;
+    uint64_t pending = 0;
+    unsigned int filled = 0;
+
+    for (std::size_t v = 0; v < count; ++v)
+    {
+        pending |= (values[v] & mask) << filled;
+        filled += bits;
+
+        if (filled >= 32)
+        {
+            uint32_t word = static_cast<uint32_t>(pending);
+            host_to_little_endian(&word, 1, 4);
+            std::memcpy(bytes, &word, 4);
+            bytes += 4;
+            pending >>= 32;
+            filled -= 32;
+        }
+    }
+
+    for (; filled > 0; filled = filled > 8? filled - 8 : 0)
+    {
+        *bytes++ = static_cast<uint8_t>(pending);
+        pending >>= 8;
+    }
+}
+
+void unpack_bits(const uint8_t * bytes, const std::size_t count, const unsigned int bits, uint32_t * values)
+{
+    const uint64_t mask = bits >= 32? 0xFFFFFFFFULL : (static_cast<uint64_t>(1) << bits) - 1;
+    const std::size_t size = packed_size(count, bits);
+    std::size_t v = 0;
+    std::size_t position = 0;
+
+    // every value lies within the eight bytes from its first byte
+    for (; v < count && position / 8 + 8 <= size; ++v, position += bits)
+    {
+        values[v] = static_cast<uint32_t>((load_little_endian(bytes + position / 8) >> (position % 8)) & mask);
+    }
+
+    if (v < count)
+    {
+        uint8_t tail[16] = {0};
+        const std::size_t tail_start = position / 8;
+        std::memcpy(tail, bytes + tail_start, size - tail_start);
+
+        for (; v < count; ++v, position += bits)
+        {
+            const std::size_t offset = position / 8 - tail_start;
+            values[v] = static_cast<uint32_t>((load_little_endian(tail + offset) >> (position % 8)) & mask);
+        }
+    }
+}
+
+
+}
@@ -0,0 +1,142 @@
+/*
+*
+*    bit_packing.hpp - packing bools eight to a byte, and unsigned integers
+*    into as few bits as their range needs
+*
+*    Both use the same order as the bool arrays of io.hpp: the first value
+*    goes in the lowest bits of the first byte. Bools are packed sixteen at a
+*    time with SSE2 where available, and n bit integers are read back with a
+*    single unaligned eight byte load each.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_BIT_PACKING_HPP
+#define GAME_DEV_UTILITIES_BIT_PACKING_HPP
+#include<cstddef>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+// bytes needed for count values of the given number of bits
+inline std::size_t packed_size(const std::size_t count, const unsigned int bits)
+{
+    return (count * bits + 7) / 8;
+}
+
+// bools to and from packed_size(count, 1) bytes, unused high bits written as 0
+void pack_bools(const bool * values, const std::size_t count, uint8_t * bytes);
+void unpack_bools(const uint8_t * bytes, const std::size_t count, bool * values);
+
+// bits must be between 1 and 32; higher bits of each value are dropped
+void pack_bits(const uint32_t * values, const std::size_t count, const unsigned int bits, uint8_t * bytes);
+void unpack_bits(const uint8_t * bytes, const std::size_t count, const unsigned int bits, uint32_t * values);
+
+// the fewest bits which hold every value up to and including max_value
+inline unsigned int bits_needed(uint32_t max_value)
+{
+    unsigned int bits = 1;
+    while (max_value >>= 1)
+    {
+        ++bits;
+    }
+    return bits;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Packed reads and writes, for any stream with read(char*, size) and
+//  write(const char*, size)
+////////////////////////////////////////////////////////////////////////////////
+
+// whole chunks are packed through a small buffer, so chunk sizes are a
+// multiple of eight values to keep every chunk on a byte boundary
+static const std::size_t bit_packing_chunk = 4096;
+
+template<typename Out>
+inline Out& write_packed_bools(Out& out, const bool * values, const std::size_t count)
+{
+    uint8_t buffer[bit_packing_chunk / 8];
+
+    for (std::size_t done = 0; done < count && out; done += bit_packing_chunk)
+    {
+        const std::size_t n = count - done < bit_packing_chunk? count - done : bit_packing_chunk;
+        pack_bools(values + done, n, buffer);
+        out.write((const char*)(buffer), packed_size(n, 1));
+    }
+    return out;
+}
+
+template<typename In>
+inline In& read_packed_bools(In& in, bool * values, const std::size_t count)
+{
+    uint8_t buffer[bit_packing_chunk / 8];
+
+    for (std::size_t done = 0; done < count && in; done += bit_packing_chunk)
+    {
+        const std::size_t n = count - done < bit_packing_chunk? count - done : bit_packing_chunk;
+        in.read((char*)(buffer), packed_size(n, 1));
+        unpack_bools(buffer, n, values + done);
+    }
+    return in;
+}
+
+template<typename Out>
+inline Out& write_packed(Out& out, const uint32_t * values, const std::size_t count, const unsigned int bits)
+{
+    static const std::size_t chunk = 1024;
+    uint8_t buffer[chunk * 4];
+
+    for (std::size_t done = 0; done < count && out; done += chunk)
+    {
+        const std::size_t n = count - done < chunk? count - done : chunk;
+        pack_bits(values + done, n, bits, buffer);
+        out.write((const char*)(buffer), packed_size(n, bits));
+    }
+    return out;
+}
+
+template<typename In>
+inline In& read_packed(In& in, uint32_t * values, const std::size_t count, const unsigned int bits)
+{
+    static const std::size_t chunk = 1024;
+    uint8_t buffer[chunk * 4];
+
+    for (std::size_t done = 0; done < count && in; done += chunk)
+    {
+        const std::size_t n = count - done < chunk? count - done : chunk;
+        in.read((char*)(buffer), packed_size(n, bits));
+        unpack_bits(buffer, n, bits, values + done);
+    }
+    return in;
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_BIT_PACKING_HPP
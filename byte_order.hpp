@@ -0,0 +1,170 @@
+/*
+*
+*    byte_order.hpp - conversion between the host byte order and the little
+*    endian order used by the binary files of io.hpp and binary_io.hpp
+*
+*    On little endian hosts, which covers x86 and nearly all ARM targets, the
+*    conversions compile down to the plain copies that were there before. On
+*    big endian hosts each value is byte swapped, sixteen bytes at a time with
+*    SSSE3 shuffles where available.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_BYTE_ORDER_HPP
+#define GAME_DEV_UTILITIES_BYTE_ORDER_HPP
+#include<cstring>
+#include<cstddef>
+#include<stdint.h>
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) \
+    || defined(__BIG_ENDIAN__) || defined(__ARMEB__) || defined(__MIPSEB__)
+#define GAME_DEV_UTILITIES_BIG_ENDIAN
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#define GAME_DEV_UTILITIES_SSSE3
+#include<tmmintrin.h>
+#endif
+
+namespace game_dev_utilities
+{
+
+inline uint16_t swap_bytes(const uint16_t value)
+{
+    return static_cast<uint16_t>((value >> 8) | (value << 8));
+}
+
+inline uint32_t swap_bytes(const uint32_t value)
+{
+    return (value >> 24) | ((value >> 8) & 0x0000FF00u) | ((value << 8) & 0x00FF0000u) | (value << 24);
+}
+
+inline uint64_t swap_bytes(const uint64_t value)
+{
+    return (static_cast<uint64_t>(swap_bytes(static_cast<uint32_t>(value))) << 32)
+        | swap_bytes(static_cast<uint32_t>(value >> 32));
+}
+
+/*
+*   Reverses the bytes of each of count values of the given width, which must
+*   be 1, 2, 4 or 8. Destination and source may be the same but must not
+*   otherwise overlap.
+*/
+inline void swap_byte_order(void * destination, const void * source, const std::size_t count, const std::size_t width)
+{
+    unsigned char * out = static_cast<unsigned char*>(destination);
+    const unsigned char * in = static_cast<const unsigned char*>(source);
+    std::size_t bytes = count * width;
+
+    if (width < 2)
+    {
+        if (out != in)
+        {
+            std::memmove(out, in, bytes);
+        }
+        return;
+    }
+
+    #ifdef GAME_DEV_UTILITIES_SSSE3
+    const __m128i mask = width == 2? _mm_set_epi8(14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1)
+        : width == 4? _mm_set_epi8(12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3)
+        : _mm_set_epi8(8,9,10,11,12,13,14,15,0,1,2,3,4,5,6,7);
+
+    for (; bytes >= 16; bytes -= 16, in += 16, out += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(block, mask));
+    }
+    #endif
+
+    for (; bytes; bytes -= width, in += width, out += width)
+    {
+        for (std::size_t b = 0; b < width / 2; ++b)
+        {
+            const unsigned char low = in[b];
+            out[b] = in[width - 1 - b];
+            out[width - 1 - b] = low;
+        }
+    }
+}
+
+// host order to and from little endian, in place
+inline void host_to_little_endian(void * values, const std::size_t count, const std::size_t width)
+{
+    #ifdef GAME_DEV_UTILITIES_BIG_ENDIAN
+    swap_byte_order(values, values, count, width);
+    #else
+    (void)values; (void)count; (void)width;
+    #endif
+}
+
+inline void little_endian_to_host(void * values, const std::size_t count, const std::size_t width)
+{
+    host_to_little_endian(values, count, width);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Stream reads and writes in little endian order, for any stream with
+//  read(char*, size) and write(const char*, size)
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename In, typename T>
+inline In& read_little_endian(In& in, T* values, const std::size_t count)
+{
+    in.read((char*)(values), count * sizeof(T));
+    little_endian_to_host(values, count, sizeof(T));
+    return in;
+}
+
+template<typename Out, typename T>
+inline Out& write_little_endian(Out& out, const T* values, const std::size_t count)
+{
+    #ifdef GAME_DEV_UTILITIES_BIG_ENDIAN
+    // swapped through a small buffer, as the values themselves are const
+    unsigned char buffer[1024];
+    const std::size_t chunk = sizeof(buffer) / sizeof(T);
+
+    for (std::size_t done = 0; done < count && out; done += chunk)
+    {
+        const std::size_t n = count - done < chunk? count - done : chunk;
+        swap_byte_order(buffer, values + done, n, sizeof(T));
+        out.write((const char*)(buffer), n * sizeof(T));
+    }
+    return out;
+    #else
+    out.write((const char*)(values), count * sizeof(T));
+    return out;
+    #endif
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_BYTE_ORDER_HPP
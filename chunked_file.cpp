@@ -0,0 +1,356 @@
+/*
+*
+*    chunked_file.cpp - files of tagged chunks with a table of contents
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"chunked_file.hpp"
+#include"io.hpp"
+#include"binary_io.hpp"
+#include"hash.hpp"
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+const uint32_t file_magic = 0x43554447; // "GDUC"
+const uint32_t contents_magic = 0x54554447; // "GDUT"
+const uint32_t file_version = 2;
+
+const std::size_t header_size = chunked_file_header_size;
+const std::size_t trailer_size = 12;
+
+inline std::size_t contents_entry_size(const uint32_t version)
+{
+    return version < 2 ? 20 : 28;
+}
+
+// checks a table of contents entry lies within the file, before the table
+bool within(const chunk_info_t & info, const uint64_t contents_offset)
+{
+    return info.offset >= header_size + chunk_header_size
+        && info.offset <= contents_offset
+        && info.size <= contents_offset - info.offset;
+}
+
+template<typename In>
+bool read_contents(In & in, const uint32_t version, const uint64_t contents_offset, const uint64_t file_size,
+    std::vector<chunk_info_t> & chunks)
+{
+    uint32_t count = 0;
+    read(in, count);
+    if (!in || count > (file_size - contents_offset) / contents_entry_size(version))
+    {
+        return false;
+    }
+
+    chunks.resize(count);
+    for (uint32_t c = 0; c < count; ++c)
+    {
+        read(in, chunks[c].tag);
+        read(in, chunks[c].offset);
+        read(in, chunks[c].size);
+        chunks[c].hash = 0;
+        if (version >= 2)
+        {
+            read(in, chunks[c].hash);
+        }
+
+        if (!within(chunks[c], contents_offset))
+        {
+            return false;
+        }
+    }
+    return static_cast<bool>(in);
+}
+
+template<typename Out>
+void write_header(Out & out)
+{
+    write(out, file_magic);
+    write(out, file_version);
+}
+
+template<typename Out>
+void write_contents(Out & out, const std::vector<chunk_info_t> & chunks, const uint64_t contents_offset)
+{
+    write(out, static_cast<uint32_t>(chunks.size()));
+    for (std::vector<chunk_info_t>::const_iterator itr = chunks.begin(); itr != chunks.end(); ++itr)
+    {
+        write(out, itr->tag);
+        write(out, itr->offset);
+        write(out, itr->size);
+        write(out, itr->hash);
+    }
+    write(out, contents_offset);
+    write(out, contents_magic);
+}
+
+} // namespace
+
+
+binary_writer_t& write_chunked_file_header(binary_writer_t& out)
+{
+    write_header(out);
+    return out;
+}
+
+binary_writer_t& write_chunk_header(binary_writer_t& out, const uint32_t tag, const uint64_t size)
+{
+    write(out, tag);
+    return write(out, size);
+}
+
+binary_writer_t& write_chunk_contents(binary_writer_t& out, const std::vector<chunk_info_t> & chunks, const uint64_t contents_offset)
+{
+    write_contents(out, chunks, contents_offset);
+    return out;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Writer
+////////////////////////////////////////////////////////////////////////////////
+
+chunked_writer_t::chunked_writer_t(std::ostream & out_in)
+:   out(out_in),
+    file_start(out_in.tellp()),
+    chunk_start(0),
+    in_chunk(false),
+    finished(false)
+{
+    write_header(out);
+}
+
+chunked_writer_t::~chunked_writer_t()
+{
+    finish();
+}
+
+std::ostream & chunked_writer_t::begin_chunk(const uint32_t tag)
+{
+    if (in_chunk)
+    {
+        end_chunk();
+    }
+
+    chunk_info_t info;
+    info.tag = tag;
+    info.size = 0;
+    info.hash = 0;
+
+    write(out, tag);
+    write(out, static_cast<uint64_t>(0)); // filled in by end_chunk
+
+    chunk_start = out.tellp();
+    info.offset = static_cast<uint64_t>(chunk_start - file_start);
+    chunks.push_back(info);
+
+    in_chunk = true;
+    return out;
+}
+
+void chunked_writer_t::end_chunk()
+{
+    if (!in_chunk)
+    {
+        return;
+    }
+    in_chunk = false;
+
+    const std::streampos chunk_end = out.tellp();
+    chunks.back().size = static_cast<uint64_t>(chunk_end - chunk_start);
+
+    out.seekp(chunk_start - static_cast<std::streamoff>(sizeof(uint64_t)));
+    write(out, chunks.back().size);
+    out.seekp(chunk_end);
+}
+
+void chunked_writer_t::write_chunk(const uint32_t tag, const char * data, const std::size_t size)
+{
+    begin_chunk(tag);
+    out.write(data, size);
+    end_chunk();
+    chunks.back().hash = hash64(data, size);
+}
+
+bool chunked_writer_t::finish()
+{
+    if (finished)
+    {
+        return static_cast<bool>(out);
+    }
+    end_chunk();
+    finished = true;
+
+    const uint64_t contents_offset = static_cast<uint64_t>(out.tellp() - file_start);
+
+    write_contents(out, chunks, contents_offset);
+
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reader
+////////////////////////////////////////////////////////////////////////////////
+
+chunked_reader_t::chunked_reader_t(std::istream & in_in)
+:   in(&in_in),
+    memory(0),
+    memory_size(0),
+    file_start(in_in.tellg()),
+    valid(false)
+{
+    valid = read_contents_from_stream();
+    in->clear();
+}
+
+chunked_reader_t::chunked_reader_t(const char * data, const std::size_t size)
+:   in(0),
+    memory(data),
+    memory_size(size),
+    file_start(0),
+    valid(false)
+{
+    valid = read_contents_from_memory();
+}
+
+bool chunked_reader_t::read_contents_from_stream()
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    read(*in, magic);
+    read(*in, version);
+    if (!*in || magic != file_magic || version == 0 || version > file_version)
+    {
+        return false;
+    }
+
+    in->seekg(0, std::ios::end);
+    const uint64_t file_size = static_cast<uint64_t>(in->tellg() - file_start);
+    if (file_size < header_size + trailer_size + sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    uint64_t contents_offset = 0;
+    in->seekg(file_start + static_cast<std::streamoff>(file_size - trailer_size));
+    read(*in, contents_offset);
+    read(*in, magic);
+    if (!*in || magic != contents_magic || contents_offset < header_size
+        || contents_offset > file_size - trailer_size - sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    in->seekg(file_start + static_cast<std::streamoff>(contents_offset));
+    return read_contents(*in, version, contents_offset, file_size, chunks);
+}
+
+bool chunked_reader_t::read_contents_from_memory()
+{
+    if (!memory || memory_size < header_size + trailer_size + sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    binary_reader_t header(memory, header_size);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    read(header, magic);
+    read(header, version);
+    if (magic != file_magic || version == 0 || version > file_version)
+    {
+        return false;
+    }
+
+    binary_reader_t trailer(memory + memory_size - trailer_size, trailer_size);
+    uint64_t contents_offset = 0;
+    read(trailer, contents_offset);
+    read(trailer, magic);
+    if (magic != contents_magic || contents_offset < header_size
+        || contents_offset > memory_size - trailer_size - sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    const std::size_t offset = static_cast<std::size_t>(contents_offset);
+    binary_reader_t contents(memory + offset, memory_size - trailer_size - offset);
+    return read_contents(contents, version, contents_offset, memory_size, chunks);
+}
+
+const chunk_info_t * chunked_reader_t::find(const uint32_t tag, std::size_t occurrence) const
+{
+    for (std::vector<chunk_info_t>::const_iterator itr = chunks.begin(); itr != chunks.end(); ++itr)
+    {
+        if (itr->tag == tag && occurrence-- == 0)
+        {
+            return &*itr;
+        }
+    }
+    return 0;
+}
+
+bool chunked_reader_t::seek(const chunk_info_t & info)
+{
+    if (!in)
+    {
+        return false;
+    }
+    in->clear();
+    in->seekg(file_start + static_cast<std::streamoff>(info.offset));
+    return static_cast<bool>(*in);
+}
+
+bool chunked_reader_t::seek(const uint32_t tag)
+{
+    const chunk_info_t * info = find(tag);
+    return info && seek(*info);
+}
+
+bool chunked_reader_t::read_chunk(const uint32_t tag, std::vector<char> & content)
+{
+    const chunk_info_t * info = find(tag);
+    if (!info)
+    {
+        return false;
+    }
+
+    content.resize(static_cast<std::size_t>(info->size));
+    if (memory)
+    {
+        content.assign(memory + info->offset, memory + info->offset + info->size);
+        return true;
+    }
+    return seek(*info) && (content.empty() || in->read(&content[0], content.size()));
+}
+
+
+}
@@ -0,0 +1,193 @@
+/*
+*
+*    chunked_file.hpp - files made of tagged, length prefixed chunks with a
+*    table of contents at the end, so that any one chunk can be read without
+*    parsing the rest of the file
+*
+*    Layout, little endian as with io.hpp:
+*
+*        uint32_t magic "GDUC", uint32_t version
+*        chunks: uint32_t tag, uint64_t size, then size bytes of content
+*        table of contents: uint32_t count, then per chunk its uint32_t tag,
+*            uint64_t offset of its content, uint64_t size and uint64_t hash
+*            (version 1 files have no hash)
+*        uint64_t offset of the table of contents, uint32_t magic "GDUT"
+*
+*    The content of a chunk is written with the usual io.hpp calls straight
+*    to the stream given to the writer, which must be seekable, as a std::
+*    ofstream or std::stringstream is, so that the size can be filled in.
+*
+*    Offsets in the table of contents may point anywhere before it, so a file
+*    can be extended with new chunks and a new table which refers back to
+*    chunks written earlier; readers only follow the last table.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_CHUNKED_FILE_HPP
+#define GAME_DEV_UTILITIES_CHUNKED_FILE_HPP
+#include<iostream>
+#include<vector>
+#include<cstddef>
+#include<stdint.h>
+#include"binary_io.hpp"
+namespace game_dev_utilities
+{
+
+static const std::size_t chunked_file_header_size = 8;
+static const std::size_t chunk_header_size = 12;
+
+// a four character tag such as make_chunk_tag('M','A','P','S')
+inline uint32_t make_chunk_tag(const char a, const char b, const char c, const char d)
+{
+    return static_cast<uint8_t>(a) | (static_cast<uint8_t>(b) << 8)
+        | (static_cast<uint8_t>(c) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+}
+
+struct chunk_info_t
+{
+    uint32_t tag;
+    uint64_t offset;    // of the content, from the start of the file
+    uint64_t size;
+    uint64_t hash;      // hash64 of the content, or 0 where it was not recorded
+};
+
+// the pieces of the layout, for writers which place chunks themselves
+binary_writer_t& write_chunked_file_header(binary_writer_t& out);
+binary_writer_t& write_chunk_header(binary_writer_t& out, const uint32_t tag, const uint64_t size);
+binary_writer_t& write_chunk_contents(binary_writer_t& out, const std::vector<chunk_info_t> & chunks, const uint64_t contents_offset);
+
+
+class chunked_writer_t
+{
+    std::ostream & out;
+    std::vector<chunk_info_t> chunks;
+    std::streampos file_start;
+    std::streampos chunk_start;
+    bool in_chunk;
+    bool finished;
+
+    chunked_writer_t(const chunked_writer_t&);
+    chunked_writer_t& operator = (const chunked_writer_t&);
+
+    public:
+
+    explicit chunked_writer_t(std::ostream & out_in);
+
+    // finishes the file if finish() has not been called
+    ~chunked_writer_t();
+
+    // everything written to stream() until end_chunk() is the chunk's content;
+    // such chunks have no hash recorded
+    std::ostream & begin_chunk(const uint32_t tag);
+    void end_chunk();
+
+    void write_chunk(const uint32_t tag, const char * data, const std::size_t size);
+
+    std::ostream & stream()
+    {
+        return out;
+    }
+
+    // ends any open chunk and writes the table of contents
+    bool finish();
+};
+
+
+/*
+*   Reads the table of contents on construction, then seeks straight to any
+*   chunk. Works on a seekable std::istream, or on a block of memory such as a
+*   mapped_file_t, in which case chunk contents can be used in place.
+*/
+class chunked_reader_t
+{
+    std::istream * in;
+    const char * memory;
+    std::size_t memory_size;
+    std::streampos file_start;
+    std::vector<chunk_info_t> chunks;
+    bool valid;
+
+    bool read_contents_from_stream();
+    bool read_contents_from_memory();
+
+    chunked_reader_t(const chunked_reader_t&);
+    chunked_reader_t& operator = (const chunked_reader_t&);
+
+    public:
+
+    explicit chunked_reader_t(std::istream & in_in);
+    chunked_reader_t(const char * data, const std::size_t size);
+
+    // false if the file is not a chunked file or its table of contents is damaged
+    bool good() const
+    {
+        return valid;
+    }
+
+    std::size_t chunk_count() const
+    {
+        return chunks.size();
+    }
+
+    const chunk_info_t & chunk(const std::size_t index) const
+    {
+        return chunks[index];
+    }
+
+    // the nth chunk with this tag, or 0 if there is none
+    const chunk_info_t * find(const uint32_t tag, const std::size_t occurrence = 0) const;
+
+    bool has_chunk(const uint32_t tag) const
+    {
+        return find(tag) != 0;
+    }
+
+    // positions stream() at the start of the chunk's content
+    bool seek(const chunk_info_t & info);
+    bool seek(const uint32_t tag);
+
+    std::istream & stream()
+    {
+        return *in;
+    }
+
+    // the chunk's content in place, for readers over memory
+    const char * data(const chunk_info_t & info) const
+    {
+        return memory ? memory + info.offset : 0;
+    }
+
+    // copies out the content of the first chunk with this tag
+    bool read_chunk(const uint32_t tag, std::vector<char> & content);
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_CHUNKED_FILE_HPP
@@ -0,0 +1,499 @@
+/*
+*
+*    compression.cpp - fast byte oriented block compression
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"compression.hpp"
+#include"io.hpp"
+#include"binary_io.hpp"
+#include"varint.hpp"
+#include<cstring>
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+const std::size_t min_match = 4;
+const std::size_t max_offset = 65535;
+const std::size_t last_literals = 5;    // a block always ends in literals
+const std::size_t match_start_limit = 12;   // and has no match starting this close to the end
+const unsigned int hash_bits = 12;
+
+inline uint32_t load32(const unsigned char * p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t load64_little_endian(const unsigned char * p)
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    little_endian_to_host(&value, 1, sizeof(value));
+    return value;
+}
+
+inline unsigned int hash_sequence(const uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+// the length of the match at p and reference, reading no further than limit
+inline std::size_t match_length(const unsigned char * p, const unsigned char * reference, const unsigned char * limit)
+{
+    const unsigned char * start = p;
+
+    while (p + 8 <= limit)
+    {
+        const uint64_t difference = load64_little_endian(p) ^ load64_little_endian(reference);
+        if (difference)
+        {
+            return p - start + lowest_set_bit(difference) / 8;
+        }
+        p += 8;
+        reference += 8;
+    }
+    while (p < limit && *p == *reference)
+    {
+        ++p;
+        ++reference;
+    }
+    return p - start;
+}
+
+// writes the extra bytes of a length which did not fit in its four bits
+inline unsigned char * write_length(unsigned char * out, std::size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        *out++ = 255;
+    }
+    *out++ = static_cast<unsigned char>(length);
+    return out;
+}
+
+// a sequence of literals followed by a match, or only literals at the end
+inline unsigned char * write_sequence(unsigned char * out, unsigned char * out_end,
+    const unsigned char * literals, const std::size_t literal_count,
+    const std::size_t offset, const std::size_t match)
+{
+    if (static_cast<std::size_t>(out_end - out) < 1 + literal_count + literal_count / 255 + 1 + 2 + match / 255 + 1)
+    {
+        return 0;
+    }
+
+    unsigned char * token = out++;
+    *token = 0;
+
+    if (literal_count >= 15)
+    {
+        *token = 15 << 4;
+        out = write_length(out, literal_count - 15);
+    }
+    else
+    {
+        *token = static_cast<unsigned char>(literal_count << 4);
+    }
+
+    std::memcpy(out, literals, literal_count);
+    out += literal_count;
+
+    if (offset)
+    {
+        *out++ = static_cast<unsigned char>(offset);
+        *out++ = static_cast<unsigned char>(offset >> 8);
+
+        const std::size_t match_code = match - min_match;
+        if (match_code >= 15)
+        {
+            *token |= 15;
+            out = write_length(out, match_code - 15);
+        }
+        else
+        {
+            *token |= static_cast<unsigned char>(match_code);
+        }
+    }
+
+    return out;
+}
+
+// returns false if the length runs past the end of the input
+inline bool read_length(const unsigned char *& in, const unsigned char * in_end, std::size_t & length)
+{
+    unsigned char extra;
+    do
+    {
+        if (in == in_end)
+        {
+            return false;
+        }
+        extra = *in++;
+        length += extra;
+    }
+    while (extra == 255);
+    return true;
+}
+
+} // namespace
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Blocks
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t compress_block(const char * source, const std::size_t size, char * destination, const std::size_t capacity)
+{
+    const unsigned char * const in = reinterpret_cast<const unsigned char*>(source);
+    const unsigned char * const in_end = in + size;
+    unsigned char * out = reinterpret_cast<unsigned char*>(destination);
+    unsigned char * const out_end = out + capacity;
+
+    const unsigned char * p = in;
+    const unsigned char * anchor = in;
+
+    if (size > match_start_limit)
+    {
+        const unsigned char * const start_limit = in_end - match_start_limit;
+        const unsigned char * const match_limit = in_end - last_literals;
+
+        uint32_t positions[1 << hash_bits];
+        std::memset(positions, 0, sizeof(positions));
+
+        while (p < start_limit)
+        {
+            const uint32_t sequence = load32(p);
+            const unsigned int hash = hash_sequence(sequence);
+            const unsigned char * reference = in + positions[hash];
+            positions[hash] = static_cast<uint32_t>(p - in);
+
+            if (reference >= p || static_cast<std::size_t>(p - reference) > max_offset || load32(reference) != sequence)
+            {
+                // step faster through data which is not matching
+                p += 1 + ((p - anchor) >> 6);
+                continue;
+            }
+
+            while (p > anchor && reference > in && p[-1] == reference[-1])
+            {
+                --p;
+                --reference;
+            }
+
+            const std::size_t match = min_match + match_length(p + min_match, reference + min_match, match_limit);
+
+            out = write_sequence(out, out_end, anchor, p - anchor, p - reference, match);
+            if (!out)
+            {
+                return 0;
+            }
+
+            p += match;
+            anchor = p;
+
+            if (p - 2 > in && p < start_limit)
+            {
+                positions[hash_sequence(load32(p - 2))] = static_cast<uint32_t>(p - 2 - in);
+            }
+        }
+    }
+
+    out = write_sequence(out, out_end, anchor, in_end - anchor, 0, 0);
+    if (!out)
+    {
+        return 0;
+    }
+    return out - reinterpret_cast<unsigned char*>(destination);
+}
+
+bool decompress_block(const char * source, const std::size_t compressed_size, char * destination, const std::size_t size)
+{
+    const unsigned char * in = reinterpret_cast<const unsigned char*>(source);
+    const unsigned char * const in_end = in + compressed_size;
+    unsigned char * const out_start = reinterpret_cast<unsigned char*>(destination);
+    unsigned char * out = out_start;
+    unsigned char * const out_end = out + size;
+
+    while (in < in_end)
+    {
+        const unsigned char token = *in++;
+
+        std::size_t literal_count = token >> 4;
+        if (literal_count == 15 && !read_length(in, in_end, literal_count))
+        {
+            return false;
+        }
+        if (literal_count > static_cast<std::size_t>(in_end - in) || literal_count > static_cast<std::size_t>(out_end - out))
+        {
+            return false;
+        }
+        std::memcpy(out, in, literal_count);
+        out += literal_count;
+        in += literal_count;
+
+        if (in == in_end)
+        {
+            break; // the final literals
+        }
+
+        if (in_end - in < 2)
+        {
+            return false;
+        }
+        const std::size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(out - out_start))
+        {
+            return false;
+        }
+
+        std::size_t match = token & 15;
+        if (match == 15 && !read_length(in, in_end, match))
+        {
+            return false;
+        }
+        match += min_match;
+        if (match > static_cast<std::size_t>(out_end - out))
+        {
+            return false;
+        }
+
+        // matches may overlap what they copy, so go in steps no longer than the offset
+        const unsigned char * reference = out - offset;
+        if (offset >= 8)
+        {
+            for (; match >= 8; match -= 8, out += 8, reference += 8)
+            {
+                std::memcpy(out, reference, 8);
+            }
+        }
+        for (; match; --match)
+        {
+            *out++ = *reference++;
+        }
+    }
+
+    return out == out_end;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Frames - a magic number, then blocks as a uint32_t raw size and a uint32_t
+//  stored size with the top bit set if the block is stored uncompressed,
+//  ending with a block of zero size
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const uint32_t frame_magic = 0x5A554447; // "GDUZ"
+const uint32_t stored_raw = 0x80000000u;
+
+std::size_t frame_block_size(const std::size_t block_size)
+{
+    return block_size < 16? 16 : block_size > max_compression_block_size? max_compression_block_size : block_size;
+}
+
+// a block of the frame, compressed into scratch if that makes it smaller
+template<typename Out>
+void write_frame_block(Out & out, const char * data, const std::size_t size, std::vector<char> & scratch)
+{
+    if (size)
+    {
+        scratch.resize(compress_bound(size));
+        const std::size_t compressed_size = compress_block(data, size, &scratch[0], scratch.size());
+
+        write(out, static_cast<uint32_t>(size));
+        if (compressed_size && compressed_size < size)
+        {
+            write(out, static_cast<uint32_t>(compressed_size));
+            out.write(&scratch[0], compressed_size);
+        }
+        else
+        {
+            write(out, static_cast<uint32_t>(size) | stored_raw);
+            out.write(data, size);
+        }
+    }
+}
+
+template<typename Out>
+void write_frame_end(Out & out)
+{
+    write(out, static_cast<uint32_t>(0));
+    write(out, static_cast<uint32_t>(0));
+}
+
+}
+
+binary_writer_t& write_compressed_frame(binary_writer_t& out, const char * data, const std::size_t size, const std::size_t block_size)
+{
+    std::vector<char> scratch;
+    const std::size_t step = frame_block_size(block_size);
+
+    write(out, frame_magic);
+    for (std::size_t done = 0; done < size && out; done += step)
+    {
+        write_frame_block(out, data + done, size - done < step? size - done : step, scratch);
+    }
+    write_frame_end(out);
+    return out;
+}
+
+compressing_streambuf_t::compressing_streambuf_t(std::ostream & out_in, const std::size_t block_size)
+:   out(out_in),
+    block(frame_block_size(block_size)),
+    compressed(compress_bound(block.size())),
+    started(false),
+    finished(false)
+{
+    setp(&block[0], &block[0] + block.size());
+}
+
+compressing_streambuf_t::~compressing_streambuf_t()
+{
+    finish();
+}
+
+bool compressing_streambuf_t::write_block()
+{
+    if (!started)
+    {
+        write(out, frame_magic);
+        started = true;
+    }
+
+    write_frame_block(out, pbase(), pptr() - pbase(), compressed);
+
+    setp(&block[0], &block[0] + block.size());
+    return static_cast<bool>(out);
+}
+
+compressing_streambuf_t::int_type compressing_streambuf_t::overflow(int_type c)
+{
+    if (finished || !write_block())
+    {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int compressing_streambuf_t::sync()
+{
+    if (finished)
+    {
+        return 0;
+    }
+    return write_block() && out.flush()? 0 : -1;
+}
+
+bool compressing_streambuf_t::finish()
+{
+    if (finished)
+    {
+        return static_cast<bool>(out);
+    }
+
+    write_block();
+    write_frame_end(out);
+    out.flush();
+
+    finished = true;
+    setp(0, 0);
+    return static_cast<bool>(out);
+}
+
+decompressing_streambuf_t::decompressing_streambuf_t(std::istream & in_in)
+:   in(in_in),
+    started(false)
+{
+    setg(0, 0, 0);
+}
+
+decompressing_streambuf_t::int_type decompressing_streambuf_t::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    if (!started)
+    {
+        uint32_t magic = 0;
+        if (!read(in, magic) || magic != frame_magic)
+        {
+            return traits_type::eof();
+        }
+        started = true;
+    }
+
+    uint32_t size = 0;
+    uint32_t stored_size = 0;
+    read(in, size);
+    read(in, stored_size);
+    const uint32_t payload = stored_size & ~stored_raw;
+    if (!in || size == 0 || size > max_compression_block_size || payload > compress_bound(size))
+    {
+        return traits_type::eof();
+    }
+
+    block.resize(size);
+
+    if (stored_size & stored_raw)
+    {
+        if (payload != size || !in.read(&block[0], size))
+        {
+            return traits_type::eof();
+        }
+    }
+    else
+    {
+        if (payload == 0)
+        {
+            return traits_type::eof();
+        }
+        compressed.resize(payload);
+        if (!in.read(&compressed[0], payload) || !decompress_block(&compressed[0], payload, &block[0], size))
+        {
+            return traits_type::eof();
+        }
+    }
+
+    setg(&block[0], &block[0], &block[0] + size);
+    return traits_type::to_int_type(*gptr());
+}
+
+
+}
@@ -0,0 +1,162 @@
+/*
+*
+*    compression.hpp - fast byte oriented block compression, and streams which
+*    compress and decompress transparently
+*
+*    The block format is that of LZ4: each sequence is a token byte holding a
+*    literal count and a match length, the literals, then a two byte offset
+*    back to the match. Matching is greedy, using a small hash table of the
+*    last place each four byte sequence was seen, so compression is a single
+*    pass and decompression is little more than copying.
+*
+*    The streams write a frame of independent blocks, each preceded by its raw
+*    and stored sizes, so anything written with io.hpp to a compressing_ostream_t
+*    reads back with io.hpp from a decompressing_istream_t.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_COMPRESSION_HPP
+#define GAME_DEV_UTILITIES_COMPRESSION_HPP
+#include<iostream>
+#include<vector>
+#include<cstddef>
+#include<stdint.h>
+#include"binary_io.hpp"
+namespace game_dev_utilities
+{
+
+// the largest a block of the given size can become
+inline std::size_t compress_bound(const std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+// returns the compressed size, or 0 if it would not fit within capacity
+std::size_t compress_block(const char * source, const std::size_t size, char * destination, const std::size_t capacity);
+
+// returns false if the block is malformed or does not decompress to exactly size bytes
+bool decompress_block(const char * source, const std::size_t compressed_size, char * destination, const std::size_t size);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Framed streams
+////////////////////////////////////////////////////////////////////////////////
+
+static const std::size_t default_compression_block_size = 64 * 1024;
+
+// larger block sizes are clamped to this when writing, and a frame naming a
+// larger block is treated as corrupt when reading, before anything is allocated
+static const std::size_t max_compression_block_size = 16 * 1024 * 1024;
+
+class compressing_streambuf_t : public std::streambuf
+{
+    std::ostream & out;
+    std::vector<char> block;
+    std::vector<char> compressed;
+    bool started;
+    bool finished;
+
+    bool write_block();
+
+    protected:
+
+    virtual int_type overflow(int_type c);
+    virtual int sync();
+
+    public:
+
+    explicit compressing_streambuf_t(std::ostream & out_in, const std::size_t block_size = default_compression_block_size);
+    virtual ~compressing_streambuf_t();
+
+    // writes what is buffered and the end of the frame; further writes fail
+    bool finish();
+};
+
+class decompressing_streambuf_t : public std::streambuf
+{
+    std::istream & in;
+    std::vector<char> block;
+    std::vector<char> compressed;
+    bool started;
+
+    protected:
+
+    virtual int_type underflow();
+
+    public:
+
+    explicit decompressing_streambuf_t(std::istream & in_in);
+};
+
+// the frame is finished on destruction, or earlier with finish()
+class compressing_ostream_t : public std::ostream
+{
+    compressing_streambuf_t buffer;
+
+    public:
+
+    explicit compressing_ostream_t(std::ostream & out, const std::size_t block_size = default_compression_block_size)
+    :   std::ostream(0),
+        buffer(out, block_size)
+    {
+        rdbuf(&buffer);
+    }
+
+    bool finish()
+    {
+        if (!buffer.finish())
+        {
+            setstate(std::ios::badbit);
+        }
+        return good();
+    }
+};
+
+// writes a whole frame at once, as a compressing_ostream_t given the same data would
+binary_writer_t& write_compressed_frame(binary_writer_t& out, const char * data, const std::size_t size,
+    const std::size_t block_size = default_compression_block_size);
+
+class decompressing_istream_t : public std::istream
+{
+    decompressing_streambuf_t buffer;
+
+    public:
+
+    explicit decompressing_istream_t(std::istream & in)
+    :   std::istream(0),
+        buffer(in)
+    {
+        rdbuf(&buffer);
+    }
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_COMPRESSION_HPP
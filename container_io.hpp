@@ -0,0 +1,448 @@
+/*
+*
+*    container_io.hpp - reading and writing standard containers, including
+*    strings, maps, sets, pairs and containers of containers
+*
+*    Included by io.hpp. The same code serves std::istream/std::ostream and
+*    binary_reader_t/binary_writer_t; each has a single read/write template
+*    for containers which forwards here.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_CONTAINER_IO_HPP
+#define GAME_DEV_UTILITIES_CONTAINER_IO_HPP
+#include"io.hpp"
+#include"bit_packing.hpp"
+#include<algorithm>
+#include<cstddef>
+#include<string>
+#include<vector>
+#include<deque>
+#include<list>
+#include<set>
+#include<map>
+#include<utility>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////////////
+
+ Every container is a uint32_t count followed by its elements, and reads
+ append to what is already in the container.
+ Elements are written with whichever read/write overload suits them, so
+ containers of strings, pairs or other containers work recursively.
+ Vectors grow a block at a time and are read in place; ints, floats and
+ doubles go through the array overloads, chars are raw bytes and bools are
+ packed.
+ Vectors of strings store all lengths before all the characters, so a whole
+ vector is two reads into two buffers rather than a read and an allocation
+ per string.
+
+*///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename C>
+struct container_io;
+
+// the most elements, or characters, a read adds to a vector or string before
+// reading them, so a corrupt count runs out of data rather than memory
+static const size_t container_read_block = 64 * 1024;
+
+template<typename T>
+inline size_t container_read_step(const T remaining)
+{
+    return remaining < container_read_block? static_cast<size_t>(remaining) : container_read_block;
+}
+
+template<typename C>
+std::istream& read(std::istream& in, C & container);
+
+template<typename C>
+std::ostream& write(std::ostream& out, const C & container);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Runs of elements - the array overloads where there are some, otherwise one
+//  read/write per element. Calls are unqualified so that binary_io.hpp
+//  overloads are found by argument dependent lookup, which is also why the
+//  members below are not called read and write.
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename Out, typename T>
+inline Out& write_elements(Out& out, const T * values, const size_t count)
+{
+    for (size_t i = 0; i < count && out; ++i)
+    {
+        write(out, values[i]);
+    }
+    return out;
+}
+
+template<typename In, typename T>
+inline In& read_elements(In& in, T * values, const size_t count)
+{
+    for (size_t i = 0; i < count && in; ++i)
+    {
+        read(in, values[i]);
+    }
+    return in;
+}
+
+#define GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(TYPE) \
+    template<typename Out> \
+    inline Out& write_elements(Out& out, const TYPE * values, const size_t count) \
+    { \
+        write(out, values, count); \
+        return out; \
+    } \
+    template<typename In> \
+    inline In& read_elements(In& in, TYPE * values, const size_t count) \
+    { \
+        read(in, values, count); \
+        return in; \
+    }
+
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(int64_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(int32_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(int16_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(int8_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(uint64_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(uint32_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(uint16_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(uint8_t)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(float)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(double)
+GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY(bool)
+
+#undef GAME_DEV_UTILITIES_CONTAINER_IO_ARRAY
+
+// write(out, const char*, count) is a sized string, so chars are copied raw
+template<typename Out>
+inline Out& write_elements(Out& out, const char * values, const size_t count)
+{
+    out.write(values, count);
+    return out;
+}
+
+template<typename In>
+inline In& read_elements(In& in, char * values, const size_t count)
+{
+    in.read(values, count);
+    return in;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Any container with begin, end, size and insert(position, value)
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename C>
+struct container_io
+{
+    template<typename Out>
+    static void write_to(Out& out, const C & container)
+    {
+        write(out, static_cast<uint32_t>(container.size()));
+        for (typename C::const_iterator it = container.begin(); it != container.end() && out; ++it)
+        {
+            write_elements(out, &*it, 1);
+        }
+    }
+
+    template<typename In>
+    static void read_from(In& in, C & container)
+    {
+        uint32_t size = 0;
+        read(in, size);
+
+        for (uint32_t i = 0; i < size && in; ++i)
+        {
+            typename C::value_type value;
+            read_elements(in, &value, 1);
+            if (in)
+            {
+                container.insert(container.end(), value);
+            }
+        }
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Vectors, read straight into resized storage
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T, typename A>
+struct container_io<std::vector<T, A> >
+{
+    template<typename Out>
+    static void write_to(Out& out, const std::vector<T, A> & container)
+    {
+        write(out, static_cast<uint32_t>(container.size()));
+        if (! container.empty())
+        {
+            write_elements(out, &container[0], container.size());
+        }
+    }
+
+    template<typename In>
+    static void read_from(In& in, std::vector<T, A> & container)
+    {
+        uint32_t size = 0;
+        read(in, size);
+
+        const size_t old_size = container.size();
+        for (size_t done = 0; done < size && in;)
+        {
+            const size_t n = container_read_step(size - done);
+            container.resize(old_size + done + n);
+            read_elements(in, &container[old_size + done], n);
+            done += n;
+        }
+        if (! in)
+        {
+            container.resize(old_size);
+        }
+    }
+};
+
+// vector<bool> has no bool array to point at, so it is packed a chunk at a time
+template<typename A>
+struct container_io<std::vector<bool, A> >
+{
+    template<typename Out>
+    static void write_to(Out& out, const std::vector<bool, A> & container)
+    {
+        const size_t size = container.size();
+        write(out, static_cast<uint32_t>(size));
+
+        bool chunk[bit_packing_chunk];
+        for (size_t done = 0; done < size && out; done += bit_packing_chunk)
+        {
+            const size_t n = size - done < bit_packing_chunk? size - done : bit_packing_chunk;
+            std::copy(container.begin() + done, container.begin() + done + n, chunk);
+            write_packed_bools(out, chunk, n);
+        }
+    }
+
+    template<typename In>
+    static void read_from(In& in, std::vector<bool, A> & container)
+    {
+        uint32_t size = 0;
+        read(in, size);
+
+        const size_t old_size = container.size();
+        container.reserve(old_size + container_read_step(size));
+
+        bool chunk[bit_packing_chunk];
+        for (size_t done = 0; done < size && in; done += bit_packing_chunk)
+        {
+            const size_t n = size - done < bit_packing_chunk? size - done : bit_packing_chunk;
+            if (read_packed_bools(in, chunk, n))
+            {
+                container.insert(container.end(), chunk, chunk + n);
+            }
+        }
+        if (! in)
+        {
+            container.resize(old_size);
+        }
+    }
+};
+
+// all the lengths, then all the characters
+template<typename A>
+struct container_io<std::vector<std::string, A> >
+{
+    template<typename Out>
+    static void write_to(Out& out, const std::vector<std::string, A> & container)
+    {
+        const size_t size = container.size();
+        write(out, static_cast<uint32_t>(size));
+
+        for (size_t i = 0; i < size && out; ++i)
+        {
+            write(out, static_cast<uint32_t>(container[i].size()));
+        }
+        for (size_t i = 0; i < size && out; ++i)
+        {
+            out.write(container[i].data(), container[i].size());
+        }
+    }
+
+    template<typename In>
+    static void read_from(In& in, std::vector<std::string, A> & container)
+    {
+        uint32_t size = 0;
+        read(in, size);
+        if (! size || ! in)
+        {
+            return;
+        }
+
+        std::vector<uint32_t> lengths;
+        for (size_t done = 0; done < size && in;)
+        {
+            const size_t n = container_read_step(size - done);
+            lengths.resize(done + n);
+            read(in, &lengths[done], n);
+            done += n;
+        }
+        if (! in)
+        {
+            return;
+        }
+
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            total += lengths[i];
+        }
+
+        std::string text;
+        for (uint64_t done = 0; done < total && in;)
+        {
+            const size_t n = container_read_step(total - done);
+            text.resize(static_cast<size_t>(done) + n);
+            in.read(&text[static_cast<size_t>(done)], n);
+            done += n;
+        }
+        if (! in)
+        {
+            return;
+        }
+
+        const size_t old_size = container.size();
+        container.resize(old_size + size);
+
+        const char * next = text.data();
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            container[old_size + i].assign(next, lengths[i]);
+            next += lengths[i];
+        }
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Maps, whose value_type has a const key and so cannot be read into
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename M>
+struct container_io_map
+{
+    template<typename Out>
+    static void write_to(Out& out, const M & container)
+    {
+        write(out, static_cast<uint32_t>(container.size()));
+        for (typename M::const_iterator it = container.begin(); it != container.end() && out; ++it)
+        {
+            write_elements(out, &it->first, 1);
+            write_elements(out, &it->second, 1);
+        }
+    }
+
+    template<typename In>
+    static void read_from(In& in, M & container)
+    {
+        uint32_t size = 0;
+        read(in, size);
+
+        for (uint32_t i = 0; i < size && in; ++i)
+        {
+            std::pair<typename M::key_type, typename M::mapped_type> value;
+            read_elements(in, &value.first, 1);
+            read_elements(in, &value.second, 1);
+            if (in)
+            {
+                container.insert(container.end(), value);
+            }
+        }
+    }
+};
+
+template<typename K, typename V, typename P, typename A>
+struct container_io<std::map<K, V, P, A> > : public container_io_map<std::map<K, V, P, A> >
+{
+};
+
+template<typename K, typename V, typename P, typename A>
+struct container_io<std::multimap<K, V, P, A> > : public container_io_map<std::multimap<K, V, P, A> >
+{
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Pairs, as first then second with no count
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename F, typename S>
+struct container_io<std::pair<F, S> >
+{
+    template<typename Out>
+    static void write_to(Out& out, const std::pair<F, S> & value)
+    {
+        write_elements(out, &value.first, 1);
+        write_elements(out, &value.second, 1);
+    }
+
+    template<typename In>
+    static void read_from(In& in, std::pair<F, S> & value)
+    {
+        read_elements(in, &value.first, 1);
+        read_elements(in, &value.second, 1);
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Stream entry points - binary_io.hpp has the same pair for its streams
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename C>
+inline std::istream& read(std::istream& in, C & container)
+{
+    container_io<C>::read_from(in, container);
+    return in;
+}
+
+template<typename C>
+inline std::ostream& write(std::ostream& out, const C & container)
+{
+    container_io<C>::write_to(out, container);
+    return out;
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_CONTAINER_IO_HPP
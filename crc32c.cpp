@@ -0,0 +1,293 @@
+/*
+*
+*    crc32c.cpp - CRC32C checksums and checksumming streams
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"crc32c.hpp"
+#include"byte_order.hpp"
+#include<cstring>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GAME_DEV_UTILITIES_CRC32C_X86
+#define GAME_DEV_UTILITIES_CRC32C_TARGET __attribute__((target("sse4.2")))
+#include<cpuid.h>
+#include<nmmintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define GAME_DEV_UTILITIES_CRC32C_X86
+#define GAME_DEV_UTILITIES_CRC32C_TARGET
+#include<intrin.h>
+#include<nmmintrin.h>
+#endif
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+const uint32_t polynomial = 0x82F63B78; // reflected Castagnoli polynomial
+
+// table[0] advances the crc by one byte, table[k] by a byte followed by k zero bytes
+struct crc32c_tables_t
+{
+    uint32_t table[8][256];
+
+    crc32c_tables_t()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ (polynomial & (0 - (crc & 1)));
+            }
+            table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            for (int k = 1; k < 8; ++k)
+            {
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const crc32c_tables_t & tables()
+{
+    static const crc32c_tables_t tables_instance;
+    return tables_instance;
+}
+
+inline uint32_t load32(const unsigned char * p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    little_endian_to_host(&value, 1, sizeof(value));
+    return value;
+}
+
+uint32_t update_portable(uint32_t crc, const unsigned char * p, std::size_t size)
+{
+    const uint32_t (&t)[8][256] = tables().table;
+
+    for (; size >= 8; p += 8, size -= 8)
+    {
+        const uint32_t low = load32(p) ^ crc;
+        const uint32_t high = load32(p + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+            ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+    for (; size; ++p, --size)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef GAME_DEV_UTILITIES_CRC32C_X86
+
+bool detect_sse42()
+{
+    #ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+    #else
+    unsigned int a, b, c, d;
+    return __get_cpuid(1, &a, &b, &c, &d) && (c & bit_SSE4_2) != 0;
+    #endif
+}
+
+GAME_DEV_UTILITIES_CRC32C_TARGET
+uint32_t update_hardware(uint32_t crc, const unsigned char * p, std::size_t size)
+{
+    for (; size && (reinterpret_cast<std::size_t>(p) & 7); ++p, --size)
+    {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+
+    #if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    for (; size >= 8; p += 8, size -= 8)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    #endif
+
+    for (; size >= 4; p += 4, size -= 4)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        crc = _mm_crc32_u32(crc, value);
+    }
+    for (; size; ++p, --size)
+    {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+
+#endif // GAME_DEV_UTILITIES_CRC32C_X86
+
+} // namespace
+
+bool crc32c_hardware_available()
+{
+    #ifdef GAME_DEV_UTILITIES_CRC32C_X86
+    static const bool available = detect_sse42();
+    return available;
+    #else
+    return false;
+    #endif
+}
+
+uint32_t crc32c(const void * data, const std::size_t size, const uint32_t crc)
+{
+    const unsigned char * p = static_cast<const unsigned char*>(data);
+
+    #ifdef GAME_DEV_UTILITIES_CRC32C_X86
+    if (crc32c_hardware_available())
+    {
+        return ~update_hardware(~crc, p, size);
+    }
+    #endif
+    return ~update_portable(~crc, p, size);
+}
+
+uint32_t crc32c_portable(const void * data, const std::size_t size, const uint32_t crc)
+{
+    return ~update_portable(~crc, static_cast<const unsigned char*>(data), size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Checksumming streams
+////////////////////////////////////////////////////////////////////////////////
+
+checksumming_streambuf_t::checksumming_streambuf_t(std::ostream & out_in, const std::size_t block_size)
+:   out(&out_in),
+    in(0),
+    block(block_size < 16? 16 : block_size),
+    checked(&block[0]),
+    crc(0)
+{
+    setp(&block[0], &block[0] + block.size());
+}
+
+checksumming_streambuf_t::checksumming_streambuf_t(std::istream & in_in, const std::size_t block_size)
+:   out(0),
+    in(&in_in),
+    block(block_size < 16? 16 : block_size),
+    checked(&block[0]),
+    crc(0)
+{
+    setg(&block[0], &block[0], &block[0]);
+}
+
+checksumming_streambuf_t::~checksumming_streambuf_t()
+{
+    if (out)
+    {
+        sync();
+    }
+}
+
+void checksumming_streambuf_t::check_to(const char * end)
+{
+    crc = crc32c(checked, end - checked, crc);
+    checked = end;
+}
+
+bool checksumming_streambuf_t::write_block()
+{
+    check_to(pptr());
+    out->write(pbase(), pptr() - pbase());
+
+    setp(&block[0], &block[0] + block.size());
+    checked = &block[0];
+    return static_cast<bool>(*out);
+}
+
+checksumming_streambuf_t::int_type checksumming_streambuf_t::overflow(int_type c)
+{
+    if (!out || !write_block())
+    {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int checksumming_streambuf_t::sync()
+{
+    if (!out)
+    {
+        return 0;
+    }
+    return write_block() && out->flush()? 0 : -1;
+}
+
+checksumming_streambuf_t::int_type checksumming_streambuf_t::underflow()
+{
+    if (!in)
+    {
+        return traits_type::eof();
+    }
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    check_to(egptr());
+
+    in->read(&block[0], block.size());
+    const std::size_t size = static_cast<std::size_t>(in->gcount());
+    if (size == 0)
+    {
+        return traits_type::eof();
+    }
+
+    setg(&block[0], &block[0], &block[0] + size);
+    checked = &block[0];
+    return traits_type::to_int_type(*gptr());
+}
+
+uint32_t checksumming_streambuf_t::checksum()
+{
+    check_to(out? pptr() : gptr());
+    return crc;
+}
+
+
+}
@@ -0,0 +1,162 @@
+/*
+*
+*    crc32c.hpp - CRC32C (Castagnoli) checksums of blocks of bytes, and stream
+*    wrappers which checksum everything passing through them
+*
+*    The SSE4.2 crc32 instruction is used when the processor has it, found at
+*    run time, so one build runs everywhere. Otherwise the checksum is worked
+*    eight bytes at a time from tables. Either way the results are the same.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_CRC32C_HPP
+#define GAME_DEV_UTILITIES_CRC32C_HPP
+#include<cstddef>
+#include<iostream>
+#include<streambuf>
+#include<vector>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////////////
+
+ Start from 0 and pass the previous result back in to checksum data which
+ arrives in pieces: crc32c(b, nb, crc32c(a, na)) == crc32c(ab, na + nb).
+
+*///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t crc32c(const void * data, const std::size_t size, const uint32_t crc = 0);
+
+// the table version alone, which crc32c uses when SSE4.2 is not available
+uint32_t crc32c_portable(const void * data, const std::size_t size, const uint32_t crc = 0);
+
+bool crc32c_hardware_available();
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Checksumming streams
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+*   Data is buffered in blocks and checksummed a block at a time. checksum()
+*   covers exactly the bytes written or read through the stream so far, so a
+*   checksum can be written after a save and checked before reading it back:
+*
+*       checksumming_ostream_t out(file);
+*       write(out, ...);
+*       write(out, out.checksum());
+*
+*       checksumming_istream_t in(file);
+*       read(in, ...);
+*       const uint32_t expected = in.checksum();
+*       uint32_t stored = 0;
+*       read(in, stored);
+*
+*   The input stream reads ahead of what it has handed out by up to a block.
+*/
+
+static const std::size_t default_checksum_block_size = 64 * 1024;
+
+class checksumming_streambuf_t : public std::streambuf
+{
+    std::ostream * out;
+    std::istream * in;
+    std::vector<char> block;
+    const char * checked;
+    uint32_t crc;
+
+    void check_to(const char * end);
+    bool write_block();
+
+    // non-copyable
+    checksumming_streambuf_t(const checksumming_streambuf_t&);
+    checksumming_streambuf_t& operator = (const checksumming_streambuf_t&);
+
+    protected:
+
+    virtual int_type overflow(int_type c);
+    virtual int sync();
+    virtual int_type underflow();
+
+    public:
+
+    explicit checksumming_streambuf_t(std::ostream & out_in, const std::size_t block_size = default_checksum_block_size);
+    explicit checksumming_streambuf_t(std::istream & in_in, const std::size_t block_size = default_checksum_block_size);
+    virtual ~checksumming_streambuf_t();
+
+    // the crc32c of every byte written or read so far
+    uint32_t checksum();
+};
+
+// buffered data is passed on by flush() and on destruction
+class checksumming_ostream_t : public std::ostream
+{
+    checksumming_streambuf_t buffer;
+
+    public:
+
+    explicit checksumming_ostream_t(std::ostream & out, const std::size_t block_size = default_checksum_block_size)
+    :   std::ostream(0),
+        buffer(out, block_size)
+    {
+        rdbuf(&buffer);
+    }
+
+    uint32_t checksum()
+    {
+        return buffer.checksum();
+    }
+};
+
+class checksumming_istream_t : public std::istream
+{
+    checksumming_streambuf_t buffer;
+
+    public:
+
+    explicit checksumming_istream_t(std::istream & in, const std::size_t block_size = default_checksum_block_size)
+    :   std::istream(0),
+        buffer(in, block_size)
+    {
+        rdbuf(&buffer);
+    }
+
+    uint32_t checksum()
+    {
+        return buffer.checksum();
+    }
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_CRC32C_HPP
@@ -0,0 +1,246 @@
+/*
+*
+*	curve_track.hpp
+*
+*   Keyframed motion curves for updating fields, for motion the fixed update
+*   methods cannot express such as easing, bounces or any piecewise cubic.
+*
+*   Curves are shared, immutable assets held contiguously in a curve library:
+*   each is a run of cubic segments built from Hermite keys. A field following
+*   a curve needs only the curve id and its time along it, which the CURVE
+*   update method keeps in param_B and param_A respectively.
+*
+*   Curves should be added while loading; adding a curve may move the storage
+*   of every curve, so it must not happen while fields are being updated.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_CURVE_TRACK_HPP
+#define GAME_DEV_UTILITIES_CURVE_TRACK_HPP
+#include<vector>
+#include<algorithm>
+#include<utility>
+#include<cstddef>
+#include<cassert>
+namespace game_dev_utilities
+{
+
+// A key of a curve: its time in ticks, its value, and the slope (change per
+// tick) arriving at and leaving the key. Differing slopes give a corner.
+struct curve_key_t
+{
+    float time;
+    float value;
+    float in_slope;
+    float out_slope;
+};
+
+inline curve_key_t make_curve_key(const float time, const float value, const float in_slope = 0, const float out_slope = 0)
+{
+    curve_key_t key = {time, value, in_slope, out_slope};
+    return key;
+}
+
+class curve_library_t
+{
+    public:
+
+        typedef unsigned int curve_id_t;
+
+    private:
+
+        // value = a + u(b + u(c + u d)), u being the time since start
+        struct segment_t
+        {
+            float start;
+            float a;
+            float b;
+            float c;
+            float d;
+        };
+
+        struct curve_t
+        {
+            unsigned int first_segment;
+            unsigned int segment_count;
+            float end_time;
+            float end_value;
+        };
+
+        std::vector<segment_t> segments;
+        std::vector<curve_t> curves;
+
+        static bool starts_after(const float time, const segment_t & segment)
+        {
+            return time < segment.start;
+        }
+
+        float evaluate(const curve_t & curve, const float time) const
+        {
+            if (time >= curve.end_time)
+            {
+                return curve.end_value;
+            }
+
+            const segment_t * first = &segments[curve.first_segment];
+            const segment_t * last = first + curve.segment_count;
+            const segment_t * segment = std::upper_bound(first, last, time, &starts_after);
+            if (segment != first)
+            {
+                --segment;
+            }
+
+            const float u = std::max(time - segment->start, 0.f);
+            return segment->a + u * (segment->b + u * (segment->c + u * segment->d));
+        }
+
+    public:
+
+        // the library used by the CURVE update method
+        static curve_library_t & shared()
+        {
+            static curve_library_t library;
+            return library;
+        }
+
+        // Builds a curve through at least two keys in increasing time order.
+        // Before the first key the curve holds the first value, after the
+        // last it holds the last.
+        curve_id_t add_curve(const curve_key_t * keys, const std::size_t key_count)
+        {
+            assert(key_count >= 2);
+
+            curve_t curve;
+            curve.first_segment = static_cast<unsigned int>(segments.size());
+            curve.segment_count = static_cast<unsigned int>(key_count - 1);
+            curve.end_time = keys[key_count - 1].time;
+            curve.end_value = keys[key_count - 1].value;
+
+            for (std::size_t k = 0; k + 1 < key_count; ++k)
+            {
+                const curve_key_t & from = keys[k];
+                const curve_key_t & to = keys[k + 1];
+                const float h = to.time - from.time;
+
+                segment_t segment = {from.time, from.value, from.out_slope, 0, 0};
+                if (h > 0)
+                {
+                    const float rise = (to.value - from.value) / h;
+                    segment.c = (3 * rise - 2 * from.out_slope - to.in_slope) / h;
+                    segment.d = (from.out_slope + to.in_slope - 2 * rise) / (h * h);
+                }
+                segments.push_back(segment);
+            }
+
+            curves.push_back(curve);
+            return static_cast<curve_id_t>(curves.size() - 1);
+        }
+
+        curve_id_t add_linear(const float from, const float to, const float duration)
+        {
+            const float slope = duration > 0 ? (to - from) / duration : 0;
+            const curve_key_t keys[2] = {make_curve_key(0, from, slope, slope), make_curve_key(duration, to, slope, slope)};
+            return add_curve(keys, 2);
+        }
+
+        curve_id_t add_ease_in_out(const float from, const float to, const float duration)
+        {
+            const curve_key_t keys[2] = {make_curve_key(0, from), make_curve_key(duration, to)};
+            return add_curve(keys, 2);
+        }
+
+        std::size_t size() const
+        {
+            return curves.size();
+        }
+
+        float end_time(const curve_id_t curve) const
+        {
+            return curves[curve].end_time;
+        }
+
+        float evaluate(const curve_id_t curve, const float time) const
+        {
+            return evaluate(curves[curve], time);
+        }
+
+        // Advances count fields following curves by one tick and evaluates
+        // them. Fields are visited grouped by curve, so that each curve's
+        // segments are read while they are in cache. The ids are the fields'
+        // param_B and the times their param_A.
+        void step(float * values, float * times, const float * ids, const std::size_t count) const
+        {
+            advance(values, times, ids, count, 1.f);
+        }
+
+        void advance(float * values, float * times, const float * ids, const std::size_t count, const float ticks) const
+        {
+            bool grouped = true;
+            for (std::size_t f = 1; f < count && grouped; ++f)
+            {
+                grouped = ids[f - 1] <= ids[f];
+            }
+
+            if (grouped)
+            {
+                for (std::size_t f = 0; f < count; ++f)
+                {
+                    times[f] += ticks;
+                    values[f] = evaluate(curves[static_cast<curve_id_t>(ids[f])], times[f]);
+                }
+                return;
+            }
+
+            // sorted a batch at a time on the stack, so nothing is allocated
+            // and workers advancing different runs share nothing
+            static const std::size_t batch_size = 256;
+            std::pair<float, unsigned int> order[batch_size];
+            for (std::size_t start = 0; start < count; start += batch_size)
+            {
+                const std::size_t batch = std::min(batch_size, count - start);
+                for (std::size_t o = 0; o < batch; ++o)
+                {
+                    order[o] = std::make_pair(ids[start + o], static_cast<unsigned int>(start + o));
+                }
+                std::sort(order, order + batch);
+
+                for (std::size_t o = 0; o < batch; ++o)
+                {
+                    const unsigned int f = order[o].second;
+                    times[f] += ticks;
+                    values[f] = evaluate(curves[static_cast<curve_id_t>(order[o].first)], times[f]);
+                }
+            }
+        }
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_CURVE_TRACK_HPP
@@ -0,0 +1,356 @@
+/*
+*
+*    delta_save.cpp - saves which only write the chunks that have changed
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"delta_save.hpp"
+#include"binary_io.hpp"
+#include"hash.hpp"
+#include"io.hpp"
+#include<cstdio>
+#include<cstring>
+#include<fstream>
+#ifndef _WIN32
+#include<unistd.h>
+#endif
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+const std::size_t trailer_size = 12;
+const std::size_t contents_entry_size = 28;
+
+// the size of an open file, leaving it positioned at the end
+bool seek_to_end(std::FILE * file, uint64_t & size)
+{
+#ifdef _WIN32
+    if (_fseeki64(file, 0, SEEK_END) != 0)
+    {
+        return false;
+    }
+    const __int64 end = _ftelli64(file);
+#else
+    if (fseeko(file, 0, SEEK_END) != 0)
+    {
+        return false;
+    }
+    const off_t end = ftello(file);
+#endif
+    size = static_cast<uint64_t>(end);
+    return end >= 0;
+}
+
+
+} // namespace
+
+
+delta_save_log_t::delta_save_log_t(const std::string & filename_in, const double compaction_ratio_in):
+    filename(filename_in),
+    compaction_ratio(compaction_ratio_in),
+    log_size(0),
+    log_valid_size(0),
+    last_written(0),
+    dirty(false)
+{
+    // do nothing //
+}
+
+bool delta_save_log_t::open()
+{
+    entries.clear();
+    log_size = 0;
+    log_valid_size = 0;
+    dirty = false;
+
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string contents;
+    copy_file_to_string(file, contents);
+    log_size = contents.size();
+
+    // the last table of contents that reads cleanly marks the last whole save
+    std::size_t end = contents.size();
+    for (;;)
+    {
+        chunked_reader_t reader(contents.data(), end);
+        if (reader.good())
+        {
+            entries.resize(reader.chunk_count());
+            for (std::size_t c = 0; c < entries.size(); ++c)
+            {
+                entries[c].info = reader.chunk(c);
+                entries[c].saved_hash = entries[c].info.hash;
+                entries[c].saved_size = entries[c].info.size;
+                entries[c].changed = false;
+            }
+            log_valid_size = end;
+            return true;
+        }
+
+        if (end < trailer_size + chunked_file_header_size)
+        {
+            break;
+        }
+        do
+        {
+            --end;
+        }
+        while (end >= 4 && std::memcmp(contents.data() + end - 4, "GDUT", 4) != 0);
+    }
+
+    log_size = 0;
+    return false;
+}
+
+delta_save_log_t::entry_t * delta_save_log_t::find(const uint32_t tag)
+{
+    for (std::vector<entry_t>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        if (itr->info.tag == tag)
+        {
+            return &*itr;
+        }
+    }
+    return 0;
+}
+
+// returns the entry to take the content if it differs from what is saved,
+// otherwise drops any pending change and returns 0
+delta_save_log_t::entry_t * delta_save_log_t::stage(const uint32_t tag, const uint64_t hash, const std::size_t size)
+{
+    entry_t * entry = find(tag);
+
+    if (!entry)
+    {
+        entries.push_back(entry_t());
+        entry = &entries.back();
+        entry->info.tag = tag;
+        entry->info.offset = 0;
+        entry->info.size = 0;
+        entry->info.hash = 0;
+        entry->saved_hash = 0;
+        entry->saved_size = 0;
+    }
+    else if (entry->info.offset && entry->saved_hash == hash && entry->saved_size == size)
+    {
+        // back to what is in the log, whatever was staged in between
+        entry->info.hash = hash;
+        entry->info.size = size;
+        entry->changed = false;
+        entry->pending.clear();
+        return 0;
+    }
+
+    entry->info.hash = hash;
+    entry->info.size = size;
+    entry->changed = true;
+    dirty = true;
+    return entry;
+}
+
+void delta_save_log_t::set_chunk(const uint32_t tag, const char * data, const std::size_t size)
+{
+    const uint64_t hash = hash64(data, size);
+    entry_t * entry = stage(tag, hash, size);
+    if (entry)
+    {
+        entry->pending.assign(data, data + size);
+    }
+}
+
+void delta_save_log_t::set_chunk(const uint32_t tag, std::vector<char> & data)
+{
+    const uint64_t hash = hash64(data.empty() ? 0 : &data[0], data.size());
+    entry_t * entry = stage(tag, hash, data.size());
+    if (entry)
+    {
+        entry->pending.swap(data);
+    }
+}
+
+void delta_save_log_t::remove_chunk(const uint32_t tag)
+{
+    entry_t * entry = find(tag);
+    if (entry)
+    {
+        entries.erase(entries.begin() + (entry - &entries[0]));
+        dirty = true;
+    }
+}
+
+uint64_t delta_save_log_t::live_size() const
+{
+    uint64_t size = chunked_file_header_size + sizeof(uint32_t) + entries.size() * contents_entry_size + trailer_size;
+    for (std::vector<entry_t>::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        size += chunk_header_size + itr->info.size;
+    }
+    return size;
+}
+
+bool delta_save_log_t::save()
+{
+    if (!dirty && log_valid_size)
+    {
+        last_written = 0;
+        return true;
+    }
+
+    uint64_t appended = sizeof(uint32_t) + entries.size() * contents_entry_size + trailer_size;
+    for (std::vector<entry_t>::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        if (itr->changed)
+        {
+            appended += chunk_header_size + itr->info.size;
+        }
+    }
+
+    const bool rewrite = !log_valid_size || (log_size + appended) > compaction_ratio * live_size();
+    return commit(rewrite);
+}
+
+bool delta_save_log_t::compact()
+{
+    return commit(true);
+}
+
+/*
+*   Appends changed chunks and a table of contents to the log, or when
+*   rewriting writes every chunk to a temporary file that replaces the log.
+*   Unchanged chunks being rewritten are read back from the old log.
+*/
+bool delta_save_log_t::commit(const bool rewrite)
+{
+    const std::string target = rewrite ? filename + ".tmp" : filename;
+    std::FILE * file = std::fopen(target.c_str(), rewrite ? "wb" : "r+b");
+    uint64_t position = 0;
+    if (!file || (!rewrite && !seek_to_end(file, position)))
+    {
+        if (file)
+        {
+            std::fclose(file);
+        }
+        return false;
+    }
+
+    std::ifstream old_log;
+    if (rewrite && log_valid_size)
+    {
+        old_log.open(filename.c_str(), std::ios::binary);
+    }
+
+    std::vector<chunk_info_t> chunks(entries.size());
+    std::vector<char> scratch;
+    const uint64_t start = position;
+    bool succeeded = true;
+    {
+        file_sink_t sink(file);
+        binary_writer_t out(sink);
+
+        if (rewrite)
+        {
+            write_chunked_file_header(out);
+            position += chunked_file_header_size;
+        }
+
+        for (std::size_t c = 0; c < entries.size(); ++c)
+        {
+            const entry_t & entry = entries[c];
+            chunks[c] = entry.info;
+
+            if (!entry.changed && !rewrite)
+            {
+                continue;
+            }
+
+            const char * data = entry.pending.empty() ? 0 : &entry.pending[0];
+            if (!entry.changed)
+            {
+                scratch.resize(static_cast<std::size_t>(entry.info.size));
+                old_log.seekg(static_cast<std::streamoff>(entry.info.offset));
+                if (!scratch.empty() && !old_log.read(&scratch[0], scratch.size()))
+                {
+                    succeeded = false;
+                    break;
+                }
+                data = scratch.empty() ? 0 : &scratch[0];
+            }
+
+            write_chunk_header(out, entry.info.tag, entry.info.size);
+            out.write(data, static_cast<std::size_t>(entry.info.size));
+
+            chunks[c].offset = position + chunk_header_size;
+            position += chunk_header_size + entry.info.size;
+        }
+
+        write_chunk_contents(out, chunks, position);
+        position += sizeof(uint32_t) + chunks.size() * contents_entry_size + trailer_size;
+
+        succeeded = out.flush() && succeeded;
+    }
+
+    succeeded = flush_to_disk(file) && succeeded;
+    succeeded = std::fclose(file) == 0 && succeeded;
+    old_log.close();
+
+    if (rewrite && (!succeeded || !replace_file(target, filename)))
+    {
+        std::remove(target.c_str());
+        return false;
+    }
+    if (!succeeded)
+    {
+        // a torn append is skipped over by open(), and appended after by the next save
+        log_size = position;
+        return false;
+    }
+
+    for (std::size_t c = 0; c < entries.size(); ++c)
+    {
+        entries[c].info.offset = chunks[c].offset;
+        entries[c].saved_hash = entries[c].info.hash;
+        entries[c].saved_size = entries[c].info.size;
+        entries[c].changed = false;
+        entries[c].pending.clear();
+    }
+
+    log_size = position;
+    log_valid_size = position;
+    last_written = position - start;
+    dirty = false;
+    return true;
+}
+
+
+}
@@ -0,0 +1,142 @@
+/*
+*
+*    delta_save.hpp - saves which only write the chunks that have changed
+*
+*    A delta_save_log_t keeps a chunked file (see chunked_file.hpp) as an
+*    append only log. Each chunk staged for a save is hashed, and only those
+*    whose hash differs from the saved copy are appended; the new table of
+*    contents then points back to the earlier copies of everything else. The
+*    cost of an autosave therefore follows what changed, not the whole state.
+*
+*    Once the log has grown to compaction_ratio times the size of what it
+*    holds, the next save rewrites it with only the live chunks, to a
+*    temporary file which is then renamed over the log.
+*
+*    The log is an ordinary chunked file, read with chunked_reader_t.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_DELTA_SAVE_HPP
+#define GAME_DEV_UTILITIES_DELTA_SAVE_HPP
+#include"chunked_file.hpp"
+#include<string>
+#include<vector>
+#include<cstddef>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+class delta_save_log_t
+{
+    public:
+
+        explicit delta_save_log_t(const std::string & filename, const double compaction_ratio = 2.0);
+
+        /*
+        *   Reads the chunks of an existing log so that the next save only
+        *   writes what differs from them. A log whose last save was cut short
+        *   is read as of the save before. Returns false, leaving the log empty,
+        *   if there is no readable log.
+        */
+        bool open();
+
+        // stages a chunk's content for the next save; tags are unique in a log
+        void set_chunk(const uint32_t tag, const char * data, const std::size_t size);
+
+        // as above, taking the content by swapping with data
+        void set_chunk(const uint32_t tag, std::vector<char> & data);
+
+        void remove_chunk(const uint32_t tag);
+
+        // appends the changed chunks and a new table of contents, or compacts
+        bool save();
+
+        // rewrites the log holding only the current chunks
+        bool compact();
+
+        std::size_t chunk_count() const
+        {
+            return entries.size();
+        }
+
+        const chunk_info_t & chunk(const std::size_t index) const
+        {
+            return entries[index].info;
+        }
+
+        // bytes in the file, and bytes it would take if compacted
+        uint64_t file_size() const
+        {
+            return log_size;
+        }
+        uint64_t live_size() const;
+
+        // bytes written by the last save
+        uint64_t last_save_size() const
+        {
+            return last_written;
+        }
+
+        // the end of the last complete save: a chunked_reader_t over the first
+        // valid_size() bytes reads the latest save even after a torn append
+        uint64_t valid_size() const
+        {
+            return log_valid_size;
+        }
+
+    private:
+
+        // info holds the staged hash and size; saved_hash and saved_size are
+        // those of the copy in the log, when info.offset is set
+        struct entry_t
+        {
+            chunk_info_t info;
+            uint64_t saved_hash;
+            uint64_t saved_size;
+            std::vector<char> pending;
+            bool changed;
+        };
+
+        entry_t * find(const uint32_t tag);
+        entry_t * stage(const uint32_t tag, const uint64_t hash, const std::size_t size);
+        bool commit(const bool rewrite);
+
+        std::string filename;
+        double compaction_ratio;
+        std::vector<entry_t> entries;
+        uint64_t log_size;
+        uint64_t log_valid_size;
+        uint64_t last_written;
+        bool dirty;
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_DELTA_SAVE_HPP
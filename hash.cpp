@@ -0,0 +1,142 @@
+/*
+*
+*    hash.cpp - a fast non cryptographic 64 bit hash of a block of bytes
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"hash.hpp"
+#include"byte_order.hpp"
+#include<cstring>
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+const uint64_t prime1 = 11400714785074694791ULL;
+const uint64_t prime2 = 14029467366897019727ULL;
+const uint64_t prime3 = 1609587929392839161ULL;
+const uint64_t prime4 = 9650029242287828579ULL;
+const uint64_t prime5 = 2870177450012600261ULL;
+
+inline uint64_t rotate_left(const uint64_t value, const unsigned int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t load64(const unsigned char * p)
+{
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    little_endian_to_host(&value, 1, sizeof(value));
+    return value;
+}
+
+inline uint32_t load32(const unsigned char * p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    little_endian_to_host(&value, 1, sizeof(value));
+    return value;
+}
+
+inline uint64_t mix_lane(uint64_t lane, const uint64_t input)
+{
+    lane += input * prime2;
+    return rotate_left(lane, 31) * prime1;
+}
+
+inline uint64_t merge_lane(uint64_t hash, const uint64_t lane)
+{
+    hash ^= mix_lane(0, lane);
+    return hash * prime1 + prime4;
+}
+
+} // namespace
+
+
+uint64_t hash64(const void * data, const std::size_t size, const uint64_t seed)
+{
+    const unsigned char * p = static_cast<const unsigned char*>(data);
+    const unsigned char * const end = p + size;
+    uint64_t hash;
+
+    if (size >= 32)
+    {
+        uint64_t lane1 = seed + prime1 + prime2;
+        uint64_t lane2 = seed + prime2;
+        uint64_t lane3 = seed;
+        uint64_t lane4 = seed - prime1;
+
+        for (const unsigned char * const limit = end - 32; p <= limit; p += 32)
+        {
+            lane1 = mix_lane(lane1, load64(p));
+            lane2 = mix_lane(lane2, load64(p + 8));
+            lane3 = mix_lane(lane3, load64(p + 16));
+            lane4 = mix_lane(lane4, load64(p + 24));
+        }
+
+        hash = rotate_left(lane1, 1) + rotate_left(lane2, 7) + rotate_left(lane3, 12) + rotate_left(lane4, 18);
+        hash = merge_lane(hash, lane1);
+        hash = merge_lane(hash, lane2);
+        hash = merge_lane(hash, lane3);
+        hash = merge_lane(hash, lane4);
+    }
+    else
+    {
+        hash = seed + prime5;
+    }
+
+    hash += size;
+
+    for (; p + 8 <= end; p += 8)
+    {
+        hash ^= mix_lane(0, load64(p));
+        hash = rotate_left(hash, 27) * prime1 + prime4;
+    }
+    if (p + 4 <= end)
+    {
+        hash ^= load32(p) * prime1;
+        hash = rotate_left(hash, 23) * prime2 + prime3;
+        p += 4;
+    }
+    for (; p < end; ++p)
+    {
+        hash ^= *p * prime5;
+        hash = rotate_left(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+
+}
@@ -0,0 +1,50 @@
+/*
+*
+*    hash.hpp - a fast non cryptographic 64 bit hash of a block of bytes
+*
+*    hash64 is the XXH64 algorithm, so hashes match those of other tools using
+*    it. It reads eight bytes at a time in four independent lanes and runs at
+*    several GB/s, which makes it cheap enough to hash whole save chunks to see
+*    whether they have changed.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_HASH_HPP
+#define GAME_DEV_UTILITIES_HASH_HPP
+#include<cstddef>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+uint64_t hash64(const void * data, const std::size_t size, const uint64_t seed = 0);
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_HASH_HPP
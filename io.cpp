@@ -31,6 +31,7 @@ SOFTWARE.
 
 */
 #include"io.hpp"
+#include"bit_packing.hpp"
 #include<iostream>
 #include<algorithm>
 #include<cstdio>
@@ -40,55 +41,16 @@ SOFTWARE.
 namespace game_dev_utilities
 {
 
-std::istream& read(std::istream& in, bool* values, const size_t bitcount)
+// packed with the first value in the lowest bit, see bit_packing.hpp
+std::istream& read(std::istream& in, bool* values, const size_t count)
 {
-    const unsigned int byte_count = bitcount/8 + (bitcount%8 && true);
-    const bool*end = values + bitcount;
-    
-    for(unsigned int t = 0; t < byte_count; ++t)
-    {
-        uint8_t bitbyte = 0;
-        read(in, bitbyte);
-        
-        for(unsigned int b = 0; b < 8; ++b)
-        {
-            if(end == values)
-            {
-                break;
-            }
-            *values = (bitbyte >> b) & 1;
-            ++values;
-        }
-    }
-    
-    return in;
+    return read_packed_bools(in, values, count);
 }
 
 
 std::ostream& write(std::ostream& out, const bool* values, const size_t count)
 {
-    const unsigned int byte_count = count/8 + (count%8 && true);
-    bool const* itr = values;
-    const bool * end = values + count;
-    
-    for(unsigned int t = 0; t < byte_count; ++t)
-    {
-        uint8_t bitbyte = 0;
-        
-        for(unsigned int b = 0; b < 8; ++b)
-        {
-            if(end == itr)
-            {
-                break;
-            }
-            bitbyte |= (*itr) << b;
-            ++itr;
-        }
-        
-        write(out, bitbyte);
-    }
-    
-    return out;
+    return write_packed_bools(out, values, count);
 }
 
 
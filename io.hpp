@@ -39,6 +39,10 @@ SOFTWARE.
 #include<sstream>
 #include<stdexcept>
 #include<fstream>
+#include<cstring>
+#include"byte_order.hpp"
+#include"string_ref.hpp"
+#include"string_conversion.hpp"
 namespace game_dev_utilities
 {
 
@@ -49,6 +53,7 @@ namespace game_dev_utilities
  All other objects should be composed of units of these reads/writes or stream read/wite methods.
  A template is not offered as these types are only available based on their exact size.
  Make sure to read using std::ios::binary
+ Values wider than a byte are stored little endian on every host (see byte_order.hpp).
 
 *///////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -60,15 +65,15 @@ namespace game_dev_utilities
     
 inline std::istream& read(std::istream& in, int64_t&value)
 {
-    return in.read((char*)(&value),sizeof(int64_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, int32_t&value)
 {
-    return in.read((char*)(&value),sizeof(int32_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, int16_t&value)
 {
-    return in.read((char*)(&value),sizeof(int16_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, int8_t&value)
 {
@@ -77,15 +82,15 @@ inline std::istream& read(std::istream& in, int8_t&value)
 
 inline std::istream& read_s64(std::istream& in, int64_t&value)
 {
-    return in.read((char*)(&value),sizeof(int64_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_s32(std::istream& in, int32_t&value)
 {
-    return in.read((char*)(&value),sizeof(int32_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_s16(std::istream& in, int16_t&value)
 {
-    return in.read((char*)(&value),sizeof(int16_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_s8(std::istream& in, int8_t&value)
 {
@@ -98,15 +103,15 @@ inline std::istream& read_s8(std::istream& in, int8_t&value)
     
 inline std::istream& read(std::istream& in, uint64_t&value)
 {
-    return in.read((char*)(&value),sizeof(uint64_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, uint32_t&value)
 {
-    return in.read((char*)(&value),sizeof(uint32_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, uint16_t&value)
 {
-    return in.read((char*)(&value),sizeof(uint16_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, uint8_t&value)
 {
@@ -115,15 +120,15 @@ inline std::istream& read(std::istream& in, uint8_t&value)
 
 inline std::istream& read_u64(std::istream& in, uint64_t&value)
 {
-    return in.read((char*)(&value),sizeof(uint64_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_u32(std::istream& in, uint32_t&value)
 {
-    return in.read((char*)(&value),sizeof(uint32_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_u16(std::istream& in, uint16_t&value)
 {
-    return in.read((char*)(&value),sizeof(uint16_t)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_u8(std::istream& in, uint8_t&value)
 {
@@ -136,15 +141,15 @@ inline std::istream& read_u8(std::istream& in, uint8_t&value)
     
 inline std::istream& read(std::istream& in, int64_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(int64_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read(std::istream& in, int32_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(int32_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read(std::istream& in, int16_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(int16_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read(std::istream& in, int8_t* values, const size_t count)
 {
@@ -154,15 +159,15 @@ inline std::istream& read(std::istream& in, int8_t* values, const size_t count)
 
 inline std::istream& read_s64(std::istream& in, int64_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(int64_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read_s32(std::istream& in, int32_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(int32_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read_s16(std::istream& in, int16_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(int16_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read_s8(std::istream& in, int8_t* values, const size_t count)
 {
@@ -175,15 +180,15 @@ inline std::istream& read_s8(std::istream& in, int8_t* values, const size_t coun
     
 inline std::istream& read(std::istream& in, uint64_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(uint64_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read(std::istream& in, uint32_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(uint32_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read(std::istream& in, uint16_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(uint16_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read(std::istream& in, uint8_t* values, const size_t count)
 {
@@ -192,15 +197,15 @@ inline std::istream& read(std::istream& in, uint8_t* values, const size_t count)
 
 inline std::istream& read_u64(std::istream& in, uint64_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(uint64_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read_u32(std::istream& in, uint32_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(uint32_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read_u16(std::istream& in, uint16_t* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(uint16_t)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 inline std::istream& read_u8(std::istream& in, uint8_t* values, const size_t count)
 {
@@ -237,20 +242,29 @@ inline std::istream& read(std::istream& in, std::string &str)
     
 inline std::istream& read(std::istream& in, float&value)
 {
-    return in.read((char*)(&value),sizeof(float)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read(std::istream& in, float* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(float)/sizeof(char));
+    return read_little_endian(in, values, count);
+}
+
+inline std::istream& read(std::istream& in, double&value)
+{
+    return read_little_endian(in, &value, 1);
+}
+inline std::istream& read(std::istream& in, double* values, const size_t count)
+{
+    return read_little_endian(in, values, count);
 }
 
 inline std::istream& read_d(std::istream& in, double&value)
 {
-    return in.read((char*)(&value),sizeof(double)/sizeof(char));
+    return read_little_endian(in, &value, 1);
 }
 inline std::istream& read_d(std::istream& in, double* values, const size_t count)
 {
-    return in.read((char*)(values), count * sizeof(double)/sizeof(char));
+    return read_little_endian(in, values, count);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -282,44 +296,21 @@ inline std::istream& read_b(std::istream& in, bool* values, const size_t count)
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-//  Read several sized unknowns into a container of those unknowns (relies on other methods resolving as desired - does not work with doubles)
-//////////////////////////////////////////////////////////////////////////////// 
-template<typename C>
-inline std::istream& read(std::istream& in, C & container)
-{
-    uint32_t size;
-    game_dev_utilities::read(in, size);
-    
-    if (size)
-    {
-        typename C::value_type * value_buffer = new typename C::value_type[size];
-        
-        game_dev_utilities::read(in, value_buffer, size);
-        container.insert(container.end(), value_buffer, value_buffer + size);
-        
-        delete[]value_buffer;
-    }
-   
-    return in;
-}
-
-
 ////////////////////////////////////////////////////////////////////////////////
 //  Write sized int
 //////////////////////////////////////////////////////////////////////////////// 
 //todo - TO BE TESTED
 inline std::ostream& write(std::ostream& out, const int64_t&value)
 {
-    return out.write((char*)(&value),sizeof(int64_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const int32_t&value)
 {
-    return out.write((char*)(&value),sizeof(int32_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const int16_t&value)
 {
-    return out.write((char*)(&value),sizeof(int16_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const int8_t&value)
 {
@@ -328,15 +319,15 @@ inline std::ostream& write(std::ostream& out, const int8_t&value)
 
 inline std::ostream& write_s64(std::ostream& out, const int64_t&value)
 {
-    return out.write((char*)(&value),sizeof(int64_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_s32(std::ostream& out, const int32_t&value)
 {
-    return out.write((char*)(&value),sizeof(int32_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_s16(std::ostream& out, const int16_t&value)
 {
-    return out.write((char*)(&value),sizeof(int16_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_s8(std::ostream& out, const int8_t&value)
 {
@@ -349,15 +340,15 @@ inline std::ostream& write_s8(std::ostream& out, const int8_t&value)
 //todo - TO BE TESTED
 inline std::ostream& write(std::ostream& out, const uint64_t&value)
 {
-    return out.write((char*)(&value),sizeof(uint64_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const uint32_t&value)
 {
-    return out.write((char*)(&value),sizeof(uint32_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const uint16_t&value)
 {
-    return out.write((char*)(&value),sizeof(uint16_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const uint8_t&value)
 {
@@ -366,15 +357,15 @@ inline std::ostream& write(std::ostream& out, const uint8_t&value)
 
 inline std::ostream& write_u64(std::ostream& out, const uint64_t&value)
 {
-    return out.write((char*)(&value),sizeof(uint64_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_u32(std::ostream& out, const uint32_t&value)
 {
-    return out.write((char*)(&value),sizeof(uint32_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_u16(std::ostream& out, const uint16_t&value)
 {
-    return out.write((char*)(&value),sizeof(uint16_t)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_u8(std::ostream& out, const uint8_t&value)
 {
@@ -388,15 +379,15 @@ inline std::ostream& write_u8(std::ostream& out, const uint8_t&value)
 //todo - TO BE TESTED
 inline std::ostream& write(std::ostream& out, const int64_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(int64_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write(std::ostream& out, const int32_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(int32_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write(std::ostream& out, const int16_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(int16_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write(std::ostream& out, const int8_t* values, const size_t count)
 {
@@ -405,15 +396,15 @@ inline std::ostream& write(std::ostream& out, const int8_t* values, const size_t
 
 inline std::ostream& write_s64(std::ostream& out, const int64_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(int64_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write_s32(std::ostream& out, const int32_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(int32_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write_s16(std::ostream& out, const int16_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(int16_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write_s8(std::ostream& out, const int8_t* values, const size_t count)
 {
@@ -426,15 +417,15 @@ inline std::ostream& write_s8(std::ostream& out, const int8_t* values, const siz
 //todo - TO BE TESTED
 inline std::ostream& write(std::ostream& out, const uint64_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(uint64_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write(std::ostream& out, const uint32_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(uint32_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write(std::ostream& out, const uint16_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(uint16_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write(std::ostream& out, const uint8_t* values, const size_t count)
 {
@@ -444,15 +435,15 @@ inline std::ostream& write(std::ostream& out, const uint8_t* values, const size_
 
 inline std::ostream& write_u64(std::ostream& out, const uint64_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(uint64_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write_u32(std::ostream& out, const uint32_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(uint32_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write_u16(std::ostream& out, const uint16_t* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(uint16_t)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 inline std::ostream& write_u8(std::ostream& out, const uint8_t* values, const size_t count)
 {
@@ -483,20 +474,29 @@ inline std::ostream& write(std::ostream& out, const std::string str)
 //todo - TO BE TESTED
 inline std::ostream& write(std::ostream& out, const float&value)
 {
-    return out.write((char*)(&value),sizeof(float)/sizeof(char));
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write(std::ostream& out, const float* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(float)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 
-inline std::ostream& write_d(std::ostream& out, const double&value) //todo  -remove _d specification
+inline std::ostream& write(std::ostream& out, const double&value)
+{
+    return write_little_endian(out, &value, 1);
+}
+inline std::ostream& write(std::ostream& out, const double* values, const size_t count)
 {
-    return out.write((char*)(&value),sizeof(double)/sizeof(char));
+    return write_little_endian(out, values, count);
+}
+
+inline std::ostream& write_d(std::ostream& out, const double&value)
+{
+    return write_little_endian(out, &value, 1);
 }
 inline std::ostream& write_d(std::ostream& out, const double* values, const size_t count)
 {
-    return out.write((char*)(values), count * sizeof(double)/sizeof(char));
+    return write_little_endian(out, values, count);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -522,21 +522,6 @@ inline std::ostream& write_b(std::ostream& out, const bool* values, const size_t
 }
 
 
-////////////////////////////////////////////////////////////////////////////////
-//  Write several sized unknowns from a container (relies on other methods)
-//////////////////////////////////////////////////////////////////////////////// 
-template<typename C>
-inline std::ostream& write(std::ostream& out, const C & container)
-{
-    game_dev_utilities::write(out, static_cast<uint32_t>(container.size()));
-    if (! container.empty())
-    {
-        game_dev_utilities::write(out, &container[0], container.size());
-    }
-    return out;
-}
-
-
 ////////////////////////////////////////////////////////////////////////////////
 //  To String method
 //////////////////////////////////////////////////////////////////////////////// 
@@ -544,9 +529,14 @@ inline std::ostream& write(std::ostream& out, const C & container)
 template<typename T>
 inline std::string to_string(T t)
 {
-    std::ostringstream oss;
-    oss << t;
-    return oss.str();
+    return string_conversion<T>::to_string(t);
+}
+
+// writes no terminating null; returns the characters written, or 0 if they would not fit
+template<typename T>
+inline std::size_t to_string(const T & t, char * buffer, const std::size_t capacity)
+{
+    return string_conversion<T>::format(t, buffer, capacity);
 }
 
 
@@ -564,15 +554,19 @@ class conversion_error : public std::invalid_argument
     }
 };
 
+// false, leaving value unspecified, unless all of str less surrounding whitespace is a T
 template<typename T>
-inline T from_string(const std::string& str)
+inline bool try_from_string(const string_ref_t& str, T& value)
 {
-    std::istringstream iss(str);
-    T t;
+    return string_conversion<T>::parse(str.begin(), str.end(), value);
+}
 
-    iss >> std::ws >> t >> std::ws;
+template<typename T>
+inline T from_string(const char* begin, const char* end)
+{
+    T t;
 
-    if(!iss.eof())
+    if(!string_conversion<T>::parse(begin, end, t))
     {
         throw conversion_error("stdaab::from_string::\tInvalid argument, failed to convert string to required type.");
     }
@@ -581,14 +575,29 @@ inline T from_string(const std::string& str)
 }
 
 template<typename T>
-inline T from_string_no_throw(const std::string& str, T value_if_error)
+inline T from_string(const string_ref_t& str)
 {
-    std::istringstream iss(str);
-    T t;
+    return from_string<T>(str.begin(), str.end());
+}
 
-    iss >> std::ws >> t >> std::ws;
+template<typename T>
+inline T from_string(const std::string& str)
+{
+    return from_string<T>(str.data(), str.data() + str.size());
+}
+
+template<typename T>
+inline T from_string(const char* str)
+{
+    return from_string<T>(str, str + std::strlen(str));
+}
 
-    if(!iss.eof())
+template<typename T>
+inline T from_string_no_throw(const char* begin, const char* end, T value_if_error)
+{
+    T t;
+
+    if(!string_conversion<T>::parse(begin, end, t))
     {
         return value_if_error;
     }
@@ -596,6 +605,23 @@ inline T from_string_no_throw(const std::string& str, T value_if_error)
     return t; 
 }
 
+template<typename T>
+inline T from_string_no_throw(const string_ref_t& str, T value_if_error)
+{
+    return from_string_no_throw<T>(str.begin(), str.end(), value_if_error);
+}
+
+template<typename T>
+inline T from_string_no_throw(const std::string& str, T value_if_error)
+{
+    return from_string_no_throw<T>(str.data(), str.data() + str.size(), value_if_error);
+}
+
+template<typename T>
+inline T from_string_no_throw(const char* str, T value_if_error)
+{
+    return from_string_no_throw<T>(str, str + std::strlen(str), value_if_error);
+}
 
 inline void copy_file_to_string(std::ifstream&file, std::string&string)
 {
@@ -609,5 +635,8 @@ inline void copy_file_to_string(std::ifstream&file, std::string&string)
 
 
 } // namespace game_dev_utilities
+
+// containers of any of the above, after them so they are visible there
+#include"container_io.hpp"
 #endif // GAME_DEV_UTILITIES_IO_HPP
 
@@ -0,0 +1,207 @@
+/*
+*
+*    mapped_file.cpp - read only memory mapped files
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"mapped_file.hpp"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include<windows.h>
+#else
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+#endif
+namespace game_dev_utilities
+{
+
+#ifdef _WIN32
+
+mapped_file_t::mapped_file_t()
+:   memory(0),
+    length(0),
+    file_handle(INVALID_HANDLE_VALUE),
+    mapping_handle(0)
+{
+    // do nothing //
+}
+
+mapped_file_t::mapped_file_t(const char * filename)
+:   memory(0),
+    length(0),
+    file_handle(INVALID_HANDLE_VALUE),
+    mapping_handle(0)
+{
+    open(filename);
+}
+
+bool mapped_file_t::open(const char * filename)
+{
+    close();
+
+    file_handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size))
+    {
+        close();
+        return false;
+    }
+
+    length = static_cast<std::size_t>(file_size.QuadPart);
+    if (length == 0)
+    {
+        return true; // nothing to map, but open
+    }
+
+    mapping_handle = CreateFileMappingA(file_handle, 0, PAGE_READONLY, 0, 0, 0);
+    if (mapping_handle)
+    {
+        memory = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!memory)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void mapped_file_t::close()
+{
+    if (memory)
+    {
+        UnmapViewOfFile(memory);
+    }
+    if (mapping_handle)
+    {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_handle);
+    }
+    memory = 0;
+    length = 0;
+    mapping_handle = 0;
+    file_handle = INVALID_HANDLE_VALUE;
+}
+
+bool mapped_file_t::is_open() const
+{
+    return file_handle != INVALID_HANDLE_VALUE;
+}
+
+#else
+
+// an open empty file has no mapping, so is marked by this non null address
+static const char empty_file = 0;
+
+mapped_file_t::mapped_file_t()
+:   memory(0),
+    length(0)
+{
+    // do nothing //
+}
+
+mapped_file_t::mapped_file_t(const char * filename)
+:   memory(0),
+    length(0)
+{
+    open(filename);
+}
+
+bool mapped_file_t::open(const char * filename)
+{
+    close();
+
+    const int descriptor = ::open(filename, O_RDONLY);
+    if (descriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0)
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    length = static_cast<std::size_t>(status.st_size);
+    if (length == 0)
+    {
+        ::close(descriptor);
+        memory = &empty_file;
+        return true;
+    }
+
+    void * mapping = mmap(0, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor); // the mapping keeps the file open
+
+    if (mapping == MAP_FAILED)
+    {
+        length = 0;
+        return false;
+    }
+
+    memory = static_cast<const char*>(mapping);
+    return true;
+}
+
+void mapped_file_t::close()
+{
+    if (memory && memory != &empty_file)
+    {
+        munmap(const_cast<char*>(memory), length);
+    }
+    memory = 0;
+    length = 0;
+}
+
+bool mapped_file_t::is_open() const
+{
+    return memory != 0;
+}
+
+#endif
+
+mapped_file_t::~mapped_file_t()
+{
+    close();
+}
+
+
+}
@@ -0,0 +1,227 @@
+/*
+*
+*    mapped_file.hpp - read only memory mapped files, and views of the arrays
+*    inside them
+*
+*    A binary_reader_t over a mapped file reads with the io.hpp overloads as
+*    usual, while read_view hands out an array_view_t pointing straight into
+*    the mapping. Large tables then load with no copy and are paged in by the
+*    system as they are first touched.
+*
+*    Views are only for types which can be copied as bytes, such as the sized
+*    ints, floats and doubles.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_MAPPED_FILE_HPP
+#define GAME_DEV_UTILITIES_MAPPED_FILE_HPP
+#include"binary_io.hpp"
+#include<vector>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+class mapped_file_t
+{
+    const char * memory;
+    std::size_t length;
+#ifdef _WIN32
+    void * file_handle;
+    void * mapping_handle;
+#endif
+
+    mapped_file_t(const mapped_file_t&);
+    mapped_file_t& operator = (const mapped_file_t&);
+
+    public:
+
+    mapped_file_t();
+
+    // check is_open() afterwards, as with a std::ifstream
+    explicit mapped_file_t(const char * filename);
+    ~mapped_file_t();
+
+    bool open(const char * filename);
+    void close();
+
+    bool is_open() const;
+
+    const char * data() const
+    {
+        return memory;
+    }
+
+    std::size_t size() const
+    {
+        return length;
+    }
+};
+
+
+/*
+*   A pointer and a count. When the data in the file is not aligned for T, or
+*   the host is big endian, the view instead holds a converted copy of it, so a
+*   view is always safe to index.
+*/
+template<typename T>
+class array_view_t
+{
+    const T * values;
+    std::size_t count;
+    std::vector<T> unaligned_copy;
+
+    public:
+
+    typedef T value_type;
+    typedef const T * const_iterator;
+
+    array_view_t() : values(0), count(0)
+    {
+        // do nothing //
+    }
+
+    array_view_t(const T * values_in, const std::size_t count_in) : values(values_in), count(count_in)
+    {
+        // do nothing //
+    }
+
+    array_view_t(const array_view_t & other)
+    :   values(other.values),
+        count(other.count),
+        unaligned_copy(other.unaligned_copy)
+    {
+        if (!unaligned_copy.empty())
+        {
+            values = &unaligned_copy[0];
+        }
+    }
+
+    array_view_t & operator = (const array_view_t & other)
+    {
+        if (this != &other)
+        {
+            unaligned_copy = other.unaligned_copy;
+            values = unaligned_copy.empty()? other.values : &unaligned_copy[0];
+            count = other.count;
+        }
+        return *this;
+    }
+
+    // points the view at bytes which may not be aligned for T
+    void assign(const char * bytes, const std::size_t count_in)
+    {
+        count = count_in;
+
+        #ifdef GAME_DEV_UTILITIES_BIG_ENDIAN
+        const bool in_place = false; // the file is little endian
+        #else
+        const bool in_place = reinterpret_cast<std::size_t>(bytes) % sizeof(T) == 0;
+        #endif
+
+        if (in_place)
+        {
+            unaligned_copy.clear();
+            values = reinterpret_cast<const T*>(bytes);
+        }
+        else
+        {
+            unaligned_copy.resize(count);
+            if (count)
+            {
+                std::memcpy(&unaligned_copy[0], bytes, count * sizeof(T));
+                little_endian_to_host(&unaligned_copy[0], count, sizeof(T));
+            }
+            values = unaligned_copy.empty()? 0 : &unaligned_copy[0];
+        }
+    }
+
+    // true if the view points into the file rather than holding a copy
+    bool is_zero_copy() const
+    {
+        return unaligned_copy.empty();
+    }
+
+    const T * data() const
+    {
+        return values;
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    const T & operator [] (const std::size_t index) const
+    {
+        return values[index];
+    }
+
+    const_iterator begin() const
+    {
+        return values;
+    }
+
+    const_iterator end() const
+    {
+        return values + count;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Views in place of array and container reads
+////////////////////////////////////////////////////////////////////////////////
+
+// as read(in, T* values, count), for readers over memory such as a mapped file
+template<typename T>
+inline binary_reader_t& read_view(binary_reader_t& in, array_view_t<T> & view, const size_t count)
+{
+    const char * bytes = in.view(count * sizeof(T));
+    view.assign(bytes, bytes? count : 0);
+    return in;
+}
+
+// as read(in, container), reading the uint32_t size and then viewing the values
+template<typename T>
+inline binary_reader_t& read_view(binary_reader_t& in, array_view_t<T> & view)
+{
+    uint32_t size = 0;
+    read(in, size);
+    return read_view(in, view, size);
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_MAPPED_FILE_HPP
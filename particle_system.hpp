@@ -0,0 +1,429 @@
+/*
+*
+*	particle_system.hpp
+*
+*   A contiguous particle system built on updating fields. Each particle's
+*   position, colour, scale and rotation are updating fields, stored by
+*   attribute in separate aligned arrays and updated in bulk with the updating
+*   field kernels; particles of one emission share their methods, so they are
+*   updated as long packed runs.
+*
+*   Particles live for a number of ticks and are removed as they expire by
+*   moving the last particle into their place, so particle indices are not
+*   stable across updates; nothing should hold on to one.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_PARTICLE_SYSTEM_HPP
+#define GAME_DEV_UTILITIES_PARTICLE_SYSTEM_HPP
+#include"updating_field.hpp"
+#include"updating_field_kernels.hpp"
+#include"aligned_allocator.hpp"
+#include"worker_pool.hpp"
+#include<vector>
+#include<algorithm>
+#include<cmath>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+// One attribute of every particle: Lanes floats per particle in each of the
+// value and parameter arrays, and one update method per particle.
+template<const std::size_t Lanes>
+class particle_column_t
+{
+	private:
+	
+		std::vector<float, aligned_allocator<float> > values;
+		std::vector<float, aligned_allocator<float> > param_As;
+		std::vector<float, aligned_allocator<float> > param_Bs;
+		std::vector<uint8_t, aligned_allocator<uint8_t> > update_methods;
+		
+	public:
+	
+		// appends count particles sharing one method and parameters
+		void append(const std::size_t count, const float * value, const updating_field_t::update_method_t update_method,
+			const float * param_A, const float * param_B)
+		{
+			for(std::size_t p = 0; p < count; ++p)
+			{
+				values.insert(values.end(), value, value + Lanes);
+				param_As.insert(param_As.end(), param_A, param_A + Lanes);
+				param_Bs.insert(param_Bs.end(), param_B, param_B + Lanes);
+			}
+			update_methods.insert(update_methods.end(), count, static_cast<uint8_t>(update_method));
+		}
+		
+		// the values of the last count particles, to be varied after appending
+		float * back(const std::size_t count)
+		{
+			return &values[values.size() - count * Lanes];
+		}
+		
+		float * back_param_A(const std::size_t count)
+		{
+			return &param_As[param_As.size() - count * Lanes];
+		}
+		
+		void remove(const std::size_t particle)
+		{
+			const std::size_t last = update_methods.size() - 1;
+			for(std::size_t lane = 0; lane < Lanes; ++lane)
+			{
+				values[particle*Lanes + lane] = values[last*Lanes + lane];
+				param_As[particle*Lanes + lane] = param_As[last*Lanes + lane];
+				param_Bs[particle*Lanes + lane] = param_Bs[last*Lanes + lane];
+			}
+			update_methods[particle] = update_methods[last];
+			
+			values.resize(last * Lanes);
+			param_As.resize(last * Lanes);
+			param_Bs.resize(last * Lanes);
+			update_methods.pop_back();
+		}
+		
+		void update(const std::size_t begin, const std::size_t end)
+		{
+			if(begin < end)
+			{
+				updating_field_kernels::update_span(&update_methods[begin], &values[begin*Lanes], &param_As[begin*Lanes], &param_Bs[begin*Lanes], end - begin, Lanes);
+			}
+		}
+		
+		void reserve(const std::size_t count)
+		{
+			values.reserve(count * Lanes);
+			param_As.reserve(count * Lanes);
+			param_Bs.reserve(count * Lanes);
+			update_methods.reserve(count);
+		}
+		
+		void clear()
+		{
+			values.clear();
+			param_As.clear();
+			param_Bs.clear();
+			update_methods.clear();
+		}
+		
+		const float * data() const
+		{
+			return values.empty() ? 0 : &values[0];
+		}
+};
+
+
+// An attribute's starting value and how it moves, as for an updating field.
+template<const std::size_t Lanes>
+struct particle_attribute_t
+{
+	float value[Lanes];
+	updating_field_t::update_method_t update_method;
+	float param_A[Lanes];
+	float param_B[Lanes];
+	
+	particle_attribute_t():
+		update_method(updating_field_t::NOTHING)
+	{
+		std::fill(value, value + Lanes, 0.f);
+		std::fill(param_A, param_A + Lanes, 0.f);
+		std::fill(param_B, param_B + Lanes, 0.f);
+	}
+	
+	void set_update_method(const updating_field_t::update_method_t update_method_in, const float * param_A_in, const float * param_B_in = 0)
+	{
+		update_method = update_method_in;
+		std::copy(param_A_in, param_A_in + Lanes, param_A);
+		if(param_B_in)
+		{
+			std::copy(param_B_in, param_B_in + Lanes, param_B);
+		}
+	}
+};
+
+
+/*
+*   Describes a burst of particles. Positions are spread randomly within
+*   spread_x, spread_y of the position value. With a speed range set, each
+*   particle's position param_A becomes a velocity at a random angle within
+*   [min_angle, max_angle] radians and a random speed, for the ADD family of
+*   methods; param_B is left as given, such as gravity for ADD_TO_ADD.
+*/
+struct particle_emitter_t
+{
+	particle_attribute_t<2> position;
+	particle_attribute_t<4> colour;
+	particle_attribute_t<1> scale;
+	particle_attribute_t<1> rotation;
+	
+	float spread_x;
+	float spread_y;
+	float min_speed;
+	float max_speed;
+	float min_angle;
+	float max_angle;
+	float min_lifetime; // in ticks
+	float max_lifetime;
+	
+	uint32_t seed;
+	
+	particle_emitter_t():
+		spread_x(0),
+		spread_y(0),
+		min_speed(0),
+		max_speed(0),
+		min_angle(0),
+		max_angle(6.2831853f),
+		min_lifetime(60),
+		max_lifetime(60),
+		seed(2463534242u)
+	{
+		colour.value[0] = colour.value[1] = colour.value[2] = colour.value[3] = 1.f;
+		scale.value[0] = 1.f;
+	}
+	
+	// a random number in [0,1), by xorshift
+	float random()
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return (seed >> 8) * (1.f / 16777216.f);
+	}
+	
+	float random(const float a, const float b)
+	{
+		return a + (b - a) * random();
+	}
+};
+
+
+class particle_system_t
+{
+	public:
+	
+		// particles per job when updating in parallel; a multiple of the cache
+		// line size in every column, so jobs never share a line
+		static const std::size_t chunk_size = 16 * cache_line_size;
+		
+	private:
+	
+		particle_column_t<2> positions;
+		particle_column_t<4> colours;
+		particle_column_t<1> scales;
+		particle_column_t<1> rotations;
+		std::vector<float, aligned_allocator<float> > lifetimes; // ticks remaining
+		std::size_t particle_count;
+		std::vector<unsigned int> expired;
+		
+		void update_range(const std::size_t begin, const std::size_t end)
+		{
+			positions.update(begin, end);
+			colours.update(begin, end);
+			scales.update(begin, end);
+			rotations.update(begin, end);
+			
+			float * life = &lifetimes[0];
+			for(std::size_t p = begin; p < end; ++p)
+			{
+				life[p] -= 1.f;
+			}
+		}
+		
+		struct chunk_job_t
+		{
+			particle_system_t * system;
+			
+			void operator()(const std::size_t chunk)
+			{
+				const std::size_t begin = chunk * chunk_size;
+				system->update_range(begin, std::min(begin + chunk_size, system->particle_count));
+			}
+		};
+		
+		// removes expired particles from the back forwards, so that each
+		// particle moved into a gap is one that has already been checked
+		void remove_expired()
+		{
+			expired.clear();
+			for(std::size_t p = 0; p < particle_count; ++p)
+			{
+				if(lifetimes[p] <= 0)
+				{
+					expired.push_back(static_cast<unsigned int>(p));
+				}
+			}
+			for(std::vector<unsigned int>::const_reverse_iterator itr = expired.rbegin(); itr != expired.rend(); ++itr)
+			{
+				remove(*itr);
+			}
+		}
+		
+	public:
+	
+		particle_system_t():
+			particle_count(0)
+		{
+			// do nothing //
+		}
+		
+		void reserve(const std::size_t count)
+		{
+			positions.reserve(count);
+			colours.reserve(count);
+			scales.reserve(count);
+			rotations.reserve(count);
+			lifetimes.reserve(count);
+		}
+		
+		void clear()
+		{
+			positions.clear();
+			colours.clear();
+			scales.clear();
+			rotations.clear();
+			lifetimes.clear();
+			particle_count = 0;
+		}
+		
+		std::size_t size() const
+		{
+			return particle_count;
+		}
+		
+		bool empty() const
+		{
+			return particle_count == 0;
+		}
+		
+		// spawns count particles from an emitter, advancing its random seed
+		void emit(particle_emitter_t & emitter, const std::size_t count)
+		{
+			// counts from rate * dt are often zero, and back(0) needs a particle
+			if(count == 0)
+			{
+				return;
+			}
+			
+			positions.append(count, emitter.position.value, emitter.position.update_method, emitter.position.param_A, emitter.position.param_B);
+			colours.append(count, emitter.colour.value, emitter.colour.update_method, emitter.colour.param_A, emitter.colour.param_B);
+			scales.append(count, emitter.scale.value, emitter.scale.update_method, emitter.scale.param_A, emitter.scale.param_B);
+			rotations.append(count, emitter.rotation.value, emitter.rotation.update_method, emitter.rotation.param_A, emitter.rotation.param_B);
+			
+			float * xy = positions.back(count);
+			float * velocity = positions.back_param_A(count);
+			const bool launched = emitter.max_speed > 0;
+			
+			for(std::size_t p = 0; p < count; ++p)
+			{
+				xy[2*p] += emitter.random(-emitter.spread_x, emitter.spread_x);
+				xy[2*p + 1] += emitter.random(-emitter.spread_y, emitter.spread_y);
+				
+				if(launched)
+				{
+					const float speed = emitter.random(emitter.min_speed, emitter.max_speed);
+					const float angle = emitter.random(emitter.min_angle, emitter.max_angle);
+					velocity[2*p] = speed * std::cos(angle);
+					velocity[2*p + 1] = speed * std::sin(angle);
+				}
+				
+				lifetimes.push_back(emitter.random(emitter.min_lifetime, emitter.max_lifetime));
+			}
+			
+			particle_count += count;
+		}
+		
+		// swaps the last particle into this one's place
+		void remove(const std::size_t particle)
+		{
+			positions.remove(particle);
+			colours.remove(particle);
+			scales.remove(particle);
+			rotations.remove(particle);
+			lifetimes[particle] = lifetimes.back();
+			lifetimes.pop_back();
+			--particle_count;
+		}
+		
+		// Updates every particle by one tick, then removes those whose
+		// lifetime has run out.
+		void update()
+		{
+			if(particle_count)
+			{
+				update_range(0, particle_count);
+			}
+			remove_expired();
+		}
+		
+		void update(worker_pool_t & workers)
+		{
+			if(particle_count <= chunk_size || workers.size() == 1)
+			{
+				update();
+				return;
+			}
+			
+			chunk_job_t job = {this};
+			workers.run((particle_count + chunk_size - 1) / chunk_size, job);
+			remove_expired();
+		}
+		
+		// Packed attributes of every particle, for drawing: x, y pairs;
+		// red, green, blue, alpha quads; and single floats for the rest.
+		const float * position_data() const
+		{
+			return positions.data();
+		}
+		
+		const float * colour_data() const
+		{
+			return colours.data();
+		}
+		
+		const float * scale_data() const
+		{
+			return scales.data();
+		}
+		
+		const float * rotation_data() const
+		{
+			return rotations.data();
+		}
+		
+		const float * lifetime_data() const
+		{
+			return lifetimes.empty() ? 0 : &lifetimes[0];
+		}
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_PARTICLE_SYSTEM_HPP
@@ -0,0 +1,438 @@
+/*
+*
+*    serial_struct.hpp - reading and writing structs from a declared list of
+*    their fields
+*
+*    After a struct, at global scope, list its fields in order:
+*
+*        struct enemy_t { int32_t id; float x, y; uint16_t health, armour; };
+*        GAME_DEV_UTILITIES_SERIAL_FIELDS_5(enemy_t, id, x, y, health, armour)
+*
+*    and write_struct, read_struct, write_structs and read_structs then work
+*    with it on std::streams, binary_writer_t and binary_reader_t. Fields are
+*    written one after another with the io.hpp overloads, and may themselves
+*    be structs with a field list.
+*
+*    When every field is a sized int, float or double, and the fields
+*    fill the struct in the order listed with no padding, the field by field
+*    bytes are exactly the bytes of the struct on a little endian host. This
+*    is worked out at compile time, and such structs, and whole arrays of
+*    them, are then written and read as a single block. The layout is only
+*    looked at for standard layout structs - with no virtual functions and
+*    no fields in a base class - as offsetof takes no other; before C++11,
+*    which cannot tell, listed structs must be standard layout.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_SERIAL_STRUCT_HPP
+#define GAME_DEV_UTILITIES_SERIAL_STRUCT_HPP
+#include"io.hpp"
+#include"binary_io.hpp"
+#include"byte_order.hpp"
+#include<cstddef>
+#include<stdint.h>
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700)
+#include<type_traits>
+#define GAME_DEV_UTILITIES_SERIAL_TYPE_TRAITS
+#endif
+namespace game_dev_utilities
+{
+
+// specialised by the field list macros
+template<typename T>
+struct serial_fields
+{
+    static const bool defined = false;
+    static const bool bulk = false;
+};
+
+// the types whose io.hpp bytes are their bytes in memory on a little endian host
+char serial_scalar_test(const int64_t&);
+char serial_scalar_test(const int32_t&);
+char serial_scalar_test(const int16_t&);
+char serial_scalar_test(const int8_t&);
+char serial_scalar_test(const uint64_t&);
+char serial_scalar_test(const uint32_t&);
+char serial_scalar_test(const uint16_t&);
+char serial_scalar_test(const uint8_t&);
+char serial_scalar_test(const float&);
+char serial_scalar_test(const double&);
+// not bool: a stored byte other than 0 or 1 read straight into one is
+// undefined, so structs with bools are read field by field
+template<typename F>
+char (&serial_scalar_test(const F&))[2];
+
+// whether offsetof may be applied to T
+template<typename T>
+struct serial_standard_layout
+{
+    #ifdef GAME_DEV_UTILITIES_SERIAL_TYPE_TRAITS
+    static const bool value = std::is_standard_layout<T>::value;
+    #else
+    static const bool value = true;
+    #endif
+};
+
+#ifdef GAME_DEV_UTILITIES_BIG_ENDIAN
+static const bool serial_bulk_allowed = false;
+#else
+static const bool serial_bulk_allowed = true;
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Single values - structs with a field list, or the io.hpp overloads
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename F, const bool Struct = serial_fields<F>::defined>
+struct serial_value
+{
+    template<typename Out>
+    static void write_value(Out & out, const F & value)
+    {
+        write(out, value);
+    }
+
+    template<typename In>
+    static void read_value(In & in, F & value)
+    {
+        read(in, value);
+    }
+};
+
+template<typename Out, typename T>
+Out & write_struct(Out & out, const T & value);
+
+template<typename In, typename T>
+In & read_struct(In & in, T & value);
+
+template<typename F>
+struct serial_value<F, true>
+{
+    template<typename Out>
+    static void write_value(Out & out, const F & value)
+    {
+        write_struct(out, value);
+    }
+
+    template<typename In>
+    static void read_value(In & in, F & value)
+    {
+        read_struct(in, value);
+    }
+};
+
+template<typename Out>
+struct serial_writer
+{
+    Out & out;
+
+    explicit serial_writer(Out & out_in) : out(out_in)
+    {
+        // do nothing //
+    }
+
+    template<typename F>
+    void operator () (const F & field)
+    {
+        serial_value<F>::write_value(out, field);
+    }
+};
+
+template<typename In>
+struct serial_reader
+{
+    In & in;
+
+    explicit serial_reader(In & in_in) : in(in_in)
+    {
+        // do nothing //
+    }
+
+    template<typename F>
+    void operator () (F & field)
+    {
+        serial_value<F>::read_value(in, field);
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Structs and arrays of structs
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename Out, typename T>
+inline Out & write_struct(Out & out, const T & value)
+{
+    if (serial_fields<T>::bulk)
+    {
+        out.write((const char*)(&value), sizeof(T));
+    }
+    else
+    {
+        serial_writer<Out> writer(out);
+        serial_fields<T>::visit(writer, value);
+    }
+    return out;
+}
+
+template<typename In, typename T>
+inline In & read_struct(In & in, T & value)
+{
+    if (serial_fields<T>::bulk)
+    {
+        in.read((char*)(&value), sizeof(T));
+    }
+    else
+    {
+        serial_reader<In> reader(in);
+        serial_fields<T>::visit(reader, value);
+    }
+    return in;
+}
+
+template<typename Out, typename T>
+inline Out & write_structs(Out & out, const T * values, const std::size_t count)
+{
+    if (serial_fields<T>::bulk)
+    {
+        out.write((const char*)(values), count * sizeof(T));
+    }
+    else
+    {
+        for (std::size_t v = 0; v < count; ++v)
+        {
+            write_struct(out, values[v]);
+        }
+    }
+    return out;
+}
+
+template<typename In, typename T>
+inline In & read_structs(In & in, T * values, const std::size_t count)
+{
+    if (serial_fields<T>::bulk)
+    {
+        in.read((char*)(values), count * sizeof(T));
+    }
+    else
+    {
+        for (std::size_t v = 0; v < count && in; ++v)
+        {
+            read_struct(in, values[v]);
+        }
+    }
+    return in;
+}
+
+
+} // namespace game_dev_utilities
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Field list macros
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+*   Each field adds its size to the running end of the layout, and the layout
+*   stays bulk copyable while every field is a scalar starting at that end.
+*   A field's offset is taken in a member template that is only instantiated
+*   for standard layout structs; any other has no offset and no bulk path.
+*/
+#define GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    namespace game_dev_utilities { \
+    template<> \
+    struct serial_fields<T> \
+    { \
+        static const bool defined = true; \
+        enum { layout_end_0 = 0, layout_packed_0 = 1 };
+
+#define GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, FIELD, INDEX, NEXT) \
+        template<typename U, const bool Standard = serial_standard_layout<U>::value> \
+        struct layout_offset_##NEXT \
+        { \
+            static const std::size_t value = offsetof(U, FIELD); \
+        }; \
+        template<typename U> \
+        struct layout_offset_##NEXT<U, false> \
+        { \
+            static const std::size_t value = static_cast<std::size_t>(-1); \
+        }; \
+        enum { \
+            layout_end_##NEXT = layout_end_##INDEX + sizeof(((T*)0)->FIELD), \
+            layout_packed_##NEXT = layout_packed_##INDEX \
+                && layout_offset_##NEXT<T>::value == static_cast<std::size_t>(layout_end_##INDEX) \
+                && sizeof(serial_scalar_test(((T*)0)->FIELD)) == 1 \
+        };
+
+#define GAME_DEV_UTILITIES_SERIAL_END(T, COUNT, VISITS) \
+        static const bool bulk = serial_bulk_allowed && layout_packed_##COUNT \
+            && static_cast<std::size_t>(layout_end_##COUNT) == sizeof(T); \
+        template<typename V> \
+        static void visit(V & visitor, T & value) \
+        { \
+            VISITS \
+        } \
+        template<typename V> \
+        static void visit(V & visitor, const T & value) \
+        { \
+            VISITS \
+        } \
+    }; \
+    }
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_1(T, f0) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 1, visitor(value.f0);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_2(T, f0, f1) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 2, visitor(value.f0); visitor(value.f1);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_3(T, f0, f1, f2) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 3, visitor(value.f0); visitor(value.f1); visitor(value.f2);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_4(T, f0, f1, f2, f3) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 4, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_5(T, f0, f1, f2, f3, f4) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 5, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_6(T, f0, f1, f2, f3, f4, f5) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 6, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_7(T, f0, f1, f2, f3, f4, f5, f6) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f6, 6, 7) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 7, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5); visitor(value.f6);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_8(T, f0, f1, f2, f3, f4, f5, f6, f7) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f6, 6, 7) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f7, 7, 8) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 8, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5); visitor(value.f6); visitor(value.f7);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_9(T, f0, f1, f2, f3, f4, f5, f6, f7, f8) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f6, 6, 7) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f7, 7, 8) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f8, 8, 9) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 9, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5); visitor(value.f6); visitor(value.f7); visitor(value.f8);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_10(T, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f6, 6, 7) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f7, 7, 8) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f8, 8, 9) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f9, 9, 10) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 10, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5); visitor(value.f6); visitor(value.f7); visitor(value.f8); visitor(value.f9);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_11(T, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f6, 6, 7) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f7, 7, 8) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f8, 8, 9) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f9, 9, 10) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f10, 10, 11) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 11, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5); visitor(value.f6); visitor(value.f7); visitor(value.f8); visitor(value.f9); visitor(value.f10);)
+
+#define GAME_DEV_UTILITIES_SERIAL_FIELDS_12(T, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11) \
+    GAME_DEV_UTILITIES_SERIAL_BEGIN(T) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f0, 0, 1) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f1, 1, 2) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f2, 2, 3) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f3, 3, 4) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f4, 4, 5) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f5, 5, 6) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f6, 6, 7) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f7, 7, 8) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f8, 8, 9) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f9, 9, 10) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f10, 10, 11) \
+    GAME_DEV_UTILITIES_SERIAL_LAYOUT(T, f11, 11, 12) \
+    GAME_DEV_UTILITIES_SERIAL_END(T, 12, visitor(value.f0); visitor(value.f1); visitor(value.f2); visitor(value.f3); visitor(value.f4); visitor(value.f5); visitor(value.f6); visitor(value.f7); visitor(value.f8); visitor(value.f9); visitor(value.f10); visitor(value.f11);)
+
+
+#endif // GAME_DEV_UTILITIES_SERIAL_STRUCT_HPP
@@ -0,0 +1,455 @@
+/*
+*
+*	static_updating_field.hpp
+*
+*   Updating fields whose update method is fixed at compile time. Where a field
+*   keeps one method for its whole life, such as a bullet moving with ADD, the
+*   method enum, the unused parameter and the switch in updating_field_t are
+*   pure overhead. Each static_updating_field<Method> stores only the
+*   parameters its method needs and its update() is a single inlined step.
+*
+*   Results are identical to an updating_field_t using the same method and
+*   parameters.
+*
+*   static_updating_field_set_t holds fields of mixed methods, grouping them by
+*   type so that each group is updated in its own tight loop.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_STATIC_UPDATING_FIELD_HPP
+#define GAME_DEV_UTILITIES_STATIC_UPDATING_FIELD_HPP
+#include"updating_field.hpp"
+#include<vector>
+#include<cmath>
+namespace game_dev_utilities
+{
+
+template<updating_field_t::update_method_t Method>
+struct static_updating_field;
+
+template<>
+struct static_updating_field<updating_field_t::NOTHING>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::NOTHING;
+	typedef static_updating_field<updating_field_t::NOTHING> stored_type;
+	
+	float value;
+	
+	explicit static_updating_field(cfloat value_in = 0):
+		value(value_in)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		// do nothing //
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::ADD>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::ADD;
+	typedef static_updating_field<updating_field_t::ADD> stored_type;
+	
+	float value;
+	float increment;
+	
+	// param_B is folded into the increment as updating_field_t adds both
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B = 0):
+		value(value_in),
+		increment(param_A + param_B)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		value += increment;
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::ADD_TO_ADD>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::ADD_TO_ADD;
+	typedef static_updating_field<updating_field_t::ADD_TO_ADD> stored_type;
+	
+	float value;
+	float increment;
+	float acceleration;
+	
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		value(value_in),
+		increment(param_A),
+		acceleration(param_B)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		value += increment;
+		increment += acceleration;
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::MULTIPLY_ADD>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::MULTIPLY_ADD;
+	typedef static_updating_field<updating_field_t::MULTIPLY_ADD> stored_type;
+	
+	float value;
+	float increment;
+	float ratio;
+	
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		value(value_in),
+		increment(param_A),
+		ratio(param_B)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		value += increment;
+		increment *= ratio;
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::MULTIPLY>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::MULTIPLY;
+	typedef static_updating_field<updating_field_t::MULTIPLY> stored_type;
+	
+	float value;
+	float multiplier;
+	
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat = 0):
+		value(value_in),
+		multiplier(param_A)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		value *= multiplier;
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::MULTIPLY_BASE>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::MULTIPLY_BASE;
+	typedef static_updating_field<updating_field_t::MULTIPLY_BASE> stored_type;
+	
+	float value;
+	float multiplier;
+	float base;
+	
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		value(value_in),
+		multiplier(param_A),
+		base(param_B)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		value = base + (value-base) * multiplier;
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::ATTENUATE>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::ATTENUATE;
+	typedef static_updating_field<updating_field_t::ATTENUATE> stored_type;
+	
+	float value;
+	float target;
+	float ratio;
+	
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		value(value_in),
+		target(param_A),
+		ratio(param_B)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		value += (target-value)*ratio;
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::ATTENUATE_LINEARLY>
+{
+	static const updating_field_t::update_method_t method = updating_field_t::ATTENUATE_LINEARLY;
+	typedef static_updating_field<updating_field_t::ATTENUATE_LINEARLY> stored_type;
+	
+	float value;
+	float target;
+	float stride;
+	
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		value(value_in),
+		target(param_A),
+		stride(param_B)
+	{
+		// do nothing //
+	}
+	
+	void update()
+	{
+		if(std::abs(target-value) <= std::abs(stride))
+		{
+			value = target;
+		}
+		else
+		{
+			value += stride;
+		}
+	}
+	
+	operator float() const
+	{
+		return value;
+	}
+};
+
+
+/*
+*   The _BA methods only swap which parameter plays which role, so their static
+*   forms are the plain forms constructed with the parameters swapped. They add
+*   no state and can be stored wherever the plain form is.
+*/
+
+template<>
+struct static_updating_field<updating_field_t::ADD_TO_ADD_BA>: public static_updating_field<updating_field_t::ADD_TO_ADD>
+{
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		static_updating_field<updating_field_t::ADD_TO_ADD>(value_in, param_B, param_A)
+	{
+		// do nothing //
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::MULTIPLY_ADD_BA>: public static_updating_field<updating_field_t::MULTIPLY_ADD>
+{
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		static_updating_field<updating_field_t::MULTIPLY_ADD>(value_in, param_B, param_A)
+	{
+		// do nothing //
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::MULTIPLY_BASE_BA>: public static_updating_field<updating_field_t::MULTIPLY_BASE>
+{
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		static_updating_field<updating_field_t::MULTIPLY_BASE>(value_in, param_B, param_A)
+	{
+		// do nothing //
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::ATTENUATE_BA>: public static_updating_field<updating_field_t::ATTENUATE>
+{
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		static_updating_field<updating_field_t::ATTENUATE>(value_in, param_B, param_A)
+	{
+		// do nothing //
+	}
+};
+
+template<>
+struct static_updating_field<updating_field_t::ATTENUATE_LINEARLY_BA>: public static_updating_field<updating_field_t::ATTENUATE_LINEARLY>
+{
+	static_updating_field(cfloat value_in, cfloat param_A, cfloat param_B):
+		static_updating_field<updating_field_t::ATTENUATE_LINEARLY>(value_in, param_B, param_A)
+	{
+		// do nothing //
+	}
+};
+
+
+/*
+*   A set of static updating fields of any method, stored contiguously by
+*   method. update() runs one loop per method with no dispatch per field.
+*
+*   Fields are addressed by their method and their index within that method's
+*   group. remove() swaps the last field of the group into the removed slot.
+*/
+class static_updating_field_set_t
+{
+	public:
+	
+		// the group a method's fields are kept in; _BA methods share the
+		// group of their plain form
+		template<updating_field_t::update_method_t Method>
+		struct group
+		{
+			typedef std::vector<typename static_updating_field<Method>::stored_type> type;
+		};
+	
+	private:
+	
+		group<updating_field_t::NOTHING>::type nothings;
+		group<updating_field_t::ADD>::type adds;
+		group<updating_field_t::ADD_TO_ADD>::type add_to_adds;
+		group<updating_field_t::MULTIPLY_ADD>::type multiply_adds;
+		group<updating_field_t::MULTIPLY>::type multiplies;
+		group<updating_field_t::MULTIPLY_BASE>::type multiply_bases;
+		group<updating_field_t::ATTENUATE>::type attenuates;
+		group<updating_field_t::ATTENUATE_LINEARLY>::type linear_attenuates;
+		
+		// overloads selected by field type, giving each type its own group
+		group<updating_field_t::NOTHING>::type & storage(static_updating_field<updating_field_t::NOTHING>*) { return nothings; }
+		group<updating_field_t::ADD>::type & storage(static_updating_field<updating_field_t::ADD>*) { return adds; }
+		group<updating_field_t::ADD_TO_ADD>::type & storage(static_updating_field<updating_field_t::ADD_TO_ADD>*) { return add_to_adds; }
+		group<updating_field_t::MULTIPLY_ADD>::type & storage(static_updating_field<updating_field_t::MULTIPLY_ADD>*) { return multiply_adds; }
+		group<updating_field_t::MULTIPLY>::type & storage(static_updating_field<updating_field_t::MULTIPLY>*) { return multiplies; }
+		group<updating_field_t::MULTIPLY_BASE>::type & storage(static_updating_field<updating_field_t::MULTIPLY_BASE>*) { return multiply_bases; }
+		group<updating_field_t::ATTENUATE>::type & storage(static_updating_field<updating_field_t::ATTENUATE>*) { return attenuates; }
+		group<updating_field_t::ATTENUATE_LINEARLY>::type & storage(static_updating_field<updating_field_t::ATTENUATE_LINEARLY>*) { return linear_attenuates; }
+		
+		template<typename G>
+		static void update_group(G & fields)
+		{
+			for(typename G::iterator itr = fields.begin(); itr != fields.end(); ++itr)
+			{
+				itr->update();
+			}
+		}
+		
+	public:
+	
+		template<updating_field_t::update_method_t Method>
+		typename group<Method>::type & fields()
+		{
+			return storage(static_cast<typename static_updating_field<Method>::stored_type*>(0));
+		}
+		
+		// returns the index of the field within its group
+		template<updating_field_t::update_method_t Method>
+		std::size_t add(const static_updating_field<Method> & field)
+		{
+			typename group<Method>::type & fields = this->fields<Method>();
+			fields.push_back(field);
+			return fields.size() - 1;
+		}
+		
+		template<updating_field_t::update_method_t Method>
+		void remove(const std::size_t index)
+		{
+			typename group<Method>::type & fields = this->fields<Method>();
+			fields[index] = fields.back();
+			fields.pop_back();
+		}
+		
+		std::size_t size() const
+		{
+			return nothings.size() + adds.size() + add_to_adds.size() + multiply_adds.size()
+				+ multiplies.size() + multiply_bases.size() + attenuates.size() + linear_attenuates.size();
+		}
+		
+		void clear()
+		{
+			nothings.clear();
+			adds.clear();
+			add_to_adds.clear();
+			multiply_adds.clear();
+			multiplies.clear();
+			multiply_bases.clear();
+			attenuates.clear();
+			linear_attenuates.clear();
+		}
+		
+		void update()
+		{
+			update_group(adds);
+			update_group(add_to_adds);
+			update_group(multiply_adds);
+			update_group(multiplies);
+			update_group(multiply_bases);
+			update_group(attenuates);
+			update_group(linear_attenuates);
+		}
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_STATIC_UPDATING_FIELD_HPP
@@ -0,0 +1,267 @@
+/*
+*
+*    string_conversion.cpp - floats and doubles to and from text
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"string_conversion.hpp"
+#include<cerrno>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include<charconv>
+#endif
+#endif
+#endif
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define GAME_DEV_UTILITIES_CHARCONV
+#endif
+namespace game_dev_utilities
+{
+
+namespace
+{
+
+inline bool same_letters(const char * begin, const char * end, const char * lower)
+{
+    for (; begin != end && *lower; ++begin, ++lower)
+    {
+        if (*begin != *lower && *begin != *lower - 'a' + 'A')
+        {
+            return false;
+        }
+    }
+    return begin == end && !*lower;
+}
+
+// the grammar in string_conversion.hpp, checked here so that strtod and
+// from_chars, which differ over hex and nan(...), take the same text; inf and
+// nan are allowed so that every value format_float writes reads back
+inline bool is_float_text(const char * begin, const char * end)
+{
+    const char * p = begin;
+    if (p != end && (*p == '+' || *p == '-'))
+    {
+        ++p;
+    }
+    if (same_letters(p, end, "inf") || same_letters(p, end, "infinity") || same_letters(p, end, "nan"))
+    {
+        return true;
+    }
+
+    bool digits = false;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+        digits = true;
+    }
+    if (p != end && *p == '.')
+    {
+        for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+        {
+            digits = true;
+        }
+    }
+    if (!digits)
+    {
+        return false;
+    }
+
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        if (p != end && (*p == '+' || *p == '-'))
+        {
+            ++p;
+        }
+        if (p == end)
+        {
+            return false;
+        }
+        for (; p != end; ++p)
+        {
+            if (*p < '0' || *p > '9')
+            {
+                return false;
+            }
+        }
+    }
+    return p == end;
+}
+
+#ifdef GAME_DEV_UTILITIES_CHARCONV
+
+template<typename F>
+bool parse_float_range(const char * begin, const char * end, F & value)
+{
+    if (!is_float_text(begin, end))
+    {
+        return false;
+    }
+
+    // from_chars takes no leading +
+    if (*begin == '+')
+    {
+        ++begin;
+    }
+
+    const std::from_chars_result result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+template<typename F>
+std::size_t format_float_range(const F value, char * buffer, const std::size_t capacity)
+{
+    const std::to_chars_result result = std::to_chars(buffer, buffer + capacity, value);
+    return result.ec == std::errc()? static_cast<std::size_t>(result.ptr - buffer) : 0;
+}
+
+#else
+
+inline double parse_c_string(const char * str, char ** end, double)
+{
+    return std::strtod(str, end);
+}
+
+inline float parse_c_string(const char * str, char ** end, float)
+{
+    #if __cplusplus >= 201103L || defined(_MSC_VER)
+    return std::strtof(str, end);
+    #else
+    return static_cast<float>(std::strtod(str, end));
+    #endif
+}
+
+inline bool same_value(const double a, const double b)
+{
+    return a == b || (a != a && b != b);
+}
+
+// strtod needs a terminating null, which a range need not have
+template<typename F>
+bool parse_float_range(const char * begin, const char * end, F & value)
+{
+    if (!is_float_text(begin, end))
+    {
+        return false;
+    }
+    const std::size_t size = end - begin;
+
+    char small[64];
+    std::string large;
+    char * str = small;
+    if (size >= sizeof(small))
+    {
+        large.assign(begin, end);
+        str = &large[0];
+    }
+    else
+    {
+        std::memcpy(small, begin, size);
+        small[size] = '\0';
+    }
+
+    errno = 0;
+    char * parsed_end = 0;
+    const F result = parse_c_string(str, &parsed_end, F());
+    // as from_chars, out of range is an overflow or an underflow to zero, but
+    // not a denormal, which strtod may flag too
+    const double magnitude = std::fabs(static_cast<double>(result));
+    if (parsed_end != str + size || (errno == ERANGE && (magnitude == 0 || magnitude > 1)))
+    {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+// as to_chars: the fewest significant digits which read back to value, then
+// whichever of fixed and exponent notation is shorter, fixed on a tie
+template<typename F>
+std::size_t format_float_range(const F value, char * buffer, const std::size_t capacity)
+{
+    const int most = sizeof(F) == sizeof(float)? 9 : 17;
+
+    char text[max_number_string_size];
+    int size = 0;
+    int digits = 1;
+    for (; digits <= most; ++digits)
+    {
+        size = std::sprintf(text, "%.*e", digits - 1, static_cast<double>(value));
+        if (digits == most || same_value(parse_c_string(text, 0, F()), value))
+        {
+            break;
+        }
+    }
+    if (size <= 0)
+    {
+        return 0;
+    }
+
+    // inf and nan have no exponent
+    const char * e = static_cast<const char*>(std::memchr(text, 'e', size));
+    if (e)
+    {
+        const int exponent = std::atoi(e + 1);
+        const int fraction = digits - 1 > exponent? digits - 1 - exponent : 0;
+        const int fixed_size = (value < 0 || text[0] == '-') + (exponent > 0? exponent + 1 : 1) + (fraction? fraction + 1 : 0);
+        if (fixed_size <= size)
+        {
+            size = std::sprintf(text, "%.*f", fraction, static_cast<double>(value));
+        }
+    }
+    return copy_number_string(text, text + size, buffer, capacity);
+}
+
+#endif // GAME_DEV_UTILITIES_CHARCONV
+
+} // namespace
+
+bool parse_float(const char * begin, const char * end, float & value)
+{
+    return parse_float_range(begin, end, value);
+}
+
+bool parse_float(const char * begin, const char * end, double & value)
+{
+    return parse_float_range(begin, end, value);
+}
+
+std::size_t format_float(const float value, char * buffer, const std::size_t capacity)
+{
+    return format_float_range(value, buffer, capacity);
+}
+
+std::size_t format_float(const double value, char * buffer, const std::size_t capacity)
+{
+    return format_float_range(value, buffer, capacity);
+}
+
+
+}
@@ -0,0 +1,324 @@
+/*
+*
+*    string_conversion.hpp - number to and from text without streams
+*
+*    Behind io.hpp's to_string and from_string. Integers, floats and doubles
+*    are parsed and formatted by hand, with no stream, locale or allocation;
+*    floats are written as the shortest text which reads back to the same
+*    value. Any other type still goes through a string stream.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_STRING_CONVERSION_HPP
+#define GAME_DEV_UTILITIES_STRING_CONVERSION_HPP
+#include<cstddef>
+#include<cstring>
+#include<string>
+#include<sstream>
+namespace game_dev_utilities
+{
+
+// enough for any integer, float or double to_string writes
+static const std::size_t max_number_string_size = 32;
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Whitespace, which from_string allows either side of a value as >> std::ws does
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool is_conversion_space(const char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline void trim_conversion_spaces(const char *& begin, const char *& end)
+{
+    while (begin != end && is_conversion_space(*begin))
+    {
+        ++begin;
+    }
+    while (end != begin && is_conversion_space(end[-1]))
+    {
+        --end;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Integers
+////////////////////////////////////////////////////////////////////////////////
+
+// fails on anything but digits, or on a value above max_value
+template<typename U>
+inline bool parse_digits(const char * begin, const char * end, const U max_value, U & value)
+{
+    if (begin == end)
+    {
+        return false;
+    }
+
+    U result = 0;
+    for (const char * p = begin; p != end; ++p)
+    {
+        const unsigned int digit = static_cast<unsigned int>(*p - '0');
+        if (digit > 9 || result > (max_value - digit) / 10)
+        {
+            return false;
+        }
+        result = static_cast<U>(result * 10 + digit);
+    }
+    value = result;
+    return true;
+}
+
+// writes the digits at the end of a buffer of at least max_number_string_size
+// and returns where they start
+template<typename U>
+inline char * format_digits(U value, char * end)
+{
+    static const char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    char * p = end;
+    while (value >= 100)
+    {
+        const unsigned int pair = static_cast<unsigned int>(value % 100) * 2;
+        value /= 100;
+        *--p = pairs[pair + 1];
+        *--p = pairs[pair];
+    }
+    if (value >= 10)
+    {
+        const unsigned int pair = static_cast<unsigned int>(value) * 2;
+        *--p = pairs[pair + 1];
+        *--p = pairs[pair];
+    }
+    else
+    {
+        *--p = static_cast<char>('0' + value);
+    }
+    return p;
+}
+
+inline std::size_t copy_number_string(const char * begin, const char * end, char * buffer, const std::size_t capacity)
+{
+    const std::size_t size = end - begin;
+    if (size > capacity)
+    {
+        return 0;
+    }
+    std::memcpy(buffer, begin, size);
+    return size;
+}
+
+template<typename U>
+inline bool parse_unsigned(const char * begin, const char * end, U & value)
+{
+    if (begin != end && *begin == '+')
+    {
+        ++begin;
+    }
+    return parse_digits(begin, end, static_cast<U>(-1), value);
+}
+
+template<typename U>
+inline std::size_t format_unsigned(const U value, char * buffer, const std::size_t capacity)
+{
+    char digits[max_number_string_size];
+    char * end = digits + max_number_string_size;
+    return copy_number_string(format_digits(value, end), end, buffer, capacity);
+}
+
+// the magnitude is worked in U, the unsigned type of the same width as S
+template<typename S, typename U>
+inline bool parse_signed(const char * begin, const char * end, S & value)
+{
+    const bool negative = begin != end && *begin == '-';
+    if (begin != end && (*begin == '-' || *begin == '+'))
+    {
+        ++begin;
+    }
+
+    const U max_positive = static_cast<U>(static_cast<U>(-1) / 2);
+    U magnitude = 0;
+    if (!parse_digits(begin, end, static_cast<U>(max_positive + negative), magnitude))
+    {
+        return false;
+    }
+    value = negative? static_cast<S>(-static_cast<S>(magnitude - 1) - 1) : static_cast<S>(magnitude);
+    return true;
+}
+
+template<typename S, typename U>
+inline std::size_t format_signed(const S value, char * buffer, const std::size_t capacity)
+{
+    char digits[max_number_string_size];
+    char * end = digits + max_number_string_size;
+
+    const U magnitude = value < 0? static_cast<U>(0 - static_cast<U>(value)) : static_cast<U>(value);
+    char * begin = format_digits(magnitude, end);
+    if (value < 0)
+    {
+        *--begin = '-';
+    }
+    return copy_number_string(begin, end, buffer, capacity);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Floats, in string_conversion.cpp - std::from_chars/to_chars where the
+//  library has them, strtod and a %.*g loop where it does not
+////////////////////////////////////////////////////////////////////////////////
+
+// takes [+-]digits[.digits][(e|E)[+-]digits] with a digit on at least one side
+// of the point, or [+-]inf, infinity or nan in any case; hex, nan(...) and
+// values which overflow or underflow to zero fail, with or without from_chars
+bool parse_float(const char * begin, const char * end, float & value);
+bool parse_float(const char * begin, const char * end, double & value);
+
+// the shortest text which parses back to exactly value, as to_chars writes it:
+// the fewest digits, in fixed or exponent notation, whichever is shorter
+std::size_t format_float(const float value, char * buffer, const std::size_t capacity);
+std::size_t format_float(const double value, char * buffer, const std::size_t capacity);
+
+
+////////////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////////////
+
+ string_conversion<T> has
+    parse(begin, end, value) - false unless the whole range, less surrounding
+        whitespace, is a T
+    format(value, buffer, capacity) - the characters written, or 0 if they
+        would not fit; no terminating null is written
+ The general case uses string streams. Chars are left to it too, so int8_t
+ and uint8_t are still read and written as characters, as with >> and <<.
+
+*///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+struct string_conversion
+{
+    static bool parse(const char * begin, const char * end, T & value)
+    {
+        std::istringstream iss(std::string(begin, end));
+        iss >> std::ws >> value >> std::ws;
+        return !iss.fail() && iss.eof();
+    }
+
+    static std::size_t format(const T & value, char * buffer, const std::size_t capacity)
+    {
+        const std::string str = to_string(value);
+        return copy_number_string(str.data(), str.data() + str.size(), buffer, capacity);
+    }
+
+    static std::string to_string(const T & value)
+    {
+        std::ostringstream oss;
+        oss << value;
+        return oss.str();
+    }
+};
+
+template<typename T>
+struct string_conversion_number
+{
+    static std::string to_string(const T & value)
+    {
+        char buffer[max_number_string_size];
+        return std::string(buffer, string_conversion<T>::format(value, buffer, max_number_string_size));
+    }
+};
+
+#define GAME_DEV_UTILITIES_STRING_CONVERSION_UNSIGNED(TYPE) \
+    template<> \
+    struct string_conversion<TYPE> : public string_conversion_number<TYPE> \
+    { \
+        static bool parse(const char * begin, const char * end, TYPE & value) \
+        { \
+            trim_conversion_spaces(begin, end); \
+            return parse_unsigned(begin, end, value); \
+        } \
+        static std::size_t format(const TYPE & value, char * buffer, const std::size_t capacity) \
+        { \
+            return format_unsigned(value, buffer, capacity); \
+        } \
+    };
+
+#define GAME_DEV_UTILITIES_STRING_CONVERSION_SIGNED(TYPE, UNSIGNED_TYPE) \
+    template<> \
+    struct string_conversion<TYPE> : public string_conversion_number<TYPE> \
+    { \
+        static bool parse(const char * begin, const char * end, TYPE & value) \
+        { \
+            trim_conversion_spaces(begin, end); \
+            return parse_signed<TYPE, UNSIGNED_TYPE>(begin, end, value); \
+        } \
+        static std::size_t format(const TYPE & value, char * buffer, const std::size_t capacity) \
+        { \
+            return format_signed<TYPE, UNSIGNED_TYPE>(value, buffer, capacity); \
+        } \
+    };
+
+#define GAME_DEV_UTILITIES_STRING_CONVERSION_FLOAT(TYPE) \
+    template<> \
+    struct string_conversion<TYPE> : public string_conversion_number<TYPE> \
+    { \
+        static bool parse(const char * begin, const char * end, TYPE & value) \
+        { \
+            trim_conversion_spaces(begin, end); \
+            return parse_float(begin, end, value); \
+        } \
+        static std::size_t format(const TYPE & value, char * buffer, const std::size_t capacity) \
+        { \
+            return format_float(value, buffer, capacity); \
+        } \
+    };
+
+GAME_DEV_UTILITIES_STRING_CONVERSION_UNSIGNED(unsigned short)
+GAME_DEV_UTILITIES_STRING_CONVERSION_UNSIGNED(unsigned int)
+GAME_DEV_UTILITIES_STRING_CONVERSION_UNSIGNED(unsigned long)
+GAME_DEV_UTILITIES_STRING_CONVERSION_UNSIGNED(unsigned long long)
+GAME_DEV_UTILITIES_STRING_CONVERSION_SIGNED(short, unsigned short)
+GAME_DEV_UTILITIES_STRING_CONVERSION_SIGNED(int, unsigned int)
+GAME_DEV_UTILITIES_STRING_CONVERSION_SIGNED(long, unsigned long)
+GAME_DEV_UTILITIES_STRING_CONVERSION_SIGNED(long long, unsigned long long)
+GAME_DEV_UTILITIES_STRING_CONVERSION_FLOAT(float)
+GAME_DEV_UTILITIES_STRING_CONVERSION_FLOAT(double)
+
+#undef GAME_DEV_UTILITIES_STRING_CONVERSION_UNSIGNED
+#undef GAME_DEV_UTILITIES_STRING_CONVERSION_SIGNED
+#undef GAME_DEV_UTILITIES_STRING_CONVERSION_FLOAT
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_STRING_CONVERSION_HPP
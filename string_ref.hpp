@@ -0,0 +1,170 @@
+/*
+*
+*    string_ref.hpp - a non-owning reference to a run of characters
+*
+*    Like std::string_view, for code built before C++17. The characters are
+*    not copied and need not be null terminated, so whatever owns them must
+*    outlive the reference.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_STRING_REF_HPP
+#define GAME_DEV_UTILITIES_STRING_REF_HPP
+#include<cstddef>
+#include<cstring>
+#include<string>
+#include<ostream>
+namespace game_dev_utilities
+{
+
+class string_ref_t
+{
+    const char * characters;
+    std::size_t length;
+
+    public:
+
+    typedef const char * const_iterator;
+
+    string_ref_t()
+    :   characters(""),
+        length(0)
+    {
+        // do nothing //
+    }
+
+    string_ref_t(const char * str)
+    :   characters(str),
+        length(std::strlen(str))
+    {
+        // do nothing //
+    }
+
+    string_ref_t(const char * str, const std::size_t size)
+    :   characters(size? str : ""),
+        length(size)
+    {
+        // do nothing //
+    }
+
+    string_ref_t(const std::string & str)
+    :   characters(str.data()),
+        length(str.size())
+    {
+        // do nothing //
+    }
+
+    const char * data() const
+    {
+        return characters;
+    }
+
+    std::size_t size() const
+    {
+        return length;
+    }
+
+    bool empty() const
+    {
+        return length == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return characters;
+    }
+
+    const_iterator end() const
+    {
+        return characters + length;
+    }
+
+    char operator [] (const std::size_t index) const
+    {
+        return characters[index];
+    }
+
+    std::string str() const
+    {
+        return std::string(characters, length);
+    }
+
+    // negative, zero or positive as with std::string::compare
+    int compare(const string_ref_t & other) const
+    {
+        const std::size_t common = length < other.length? length : other.length;
+        const int result = common? std::memcmp(characters, other.characters, common) : 0;
+        if (result != 0)
+        {
+            return result;
+        }
+        return length < other.length? -1 : (length > other.length? 1 : 0);
+    }
+};
+
+inline bool operator == (const string_ref_t & a, const string_ref_t & b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator != (const string_ref_t & a, const string_ref_t & b)
+{
+    return !(a == b);
+}
+
+inline bool operator < (const string_ref_t & a, const string_ref_t & b)
+{
+    return a.compare(b) < 0;
+}
+
+inline bool operator > (const string_ref_t & a, const string_ref_t & b)
+{
+    return b.compare(a) < 0;
+}
+
+inline bool operator <= (const string_ref_t & a, const string_ref_t & b)
+{
+    return !(b < a);
+}
+
+inline bool operator >= (const string_ref_t & a, const string_ref_t & b)
+{
+    return !(a < b);
+}
+
+inline std::ostream& operator << (std::ostream& out, const string_ref_t & str)
+{
+    out.write(str.data(), str.size());
+    return out;
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_STRING_REF_HPP
@@ -0,0 +1,82 @@
+/*
+*
+*    string_table.cpp - the string arena behind string tables
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"string_table.hpp"
+namespace game_dev_utilities
+{
+
+string_arena_t::string_arena_t(const std::size_t chunk_size_in)
+:   next(0),
+    remaining(0),
+    chunk_size(chunk_size_in < 256? 256 : chunk_size_in)
+{
+    // do nothing //
+}
+
+string_arena_t::~string_arena_t()
+{
+    clear();
+}
+
+char * string_arena_t::allocate(const std::size_t size)
+{
+    if (size > remaining)
+    {
+        // long strings get a chunk of their own so the current one is not wasted
+        if (size > chunk_size / 4)
+        {
+            chunks.push_back(new char[size]);
+            return chunks.back();
+        }
+
+        chunks.push_back(new char[chunk_size]);
+        next = chunks.back();
+        remaining = chunk_size;
+    }
+
+    char * block = next;
+    next += size;
+    remaining -= size;
+    return block;
+}
+
+void string_arena_t::clear()
+{
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        delete[] chunks[i];
+    }
+    chunks.clear();
+    next = 0;
+    remaining = 0;
+}
+
+
+}
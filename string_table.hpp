@@ -0,0 +1,279 @@
+/*
+*
+*    string_table.hpp - writing repeated strings once, and reading them back
+*    as references into one arena
+*
+*    Saves name the same item and entity types over and over. Through a
+*    string table each distinct string is written in full the first time only;
+*    every later occurrence is a varint index, usually a single byte. Reading
+*    copies each distinct string once into a chunked arena and hands out
+*    string_ref_t references to it, so loading makes a few large allocations
+*    instead of one per string.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_STRING_TABLE_HPP
+#define GAME_DEV_UTILITIES_STRING_TABLE_HPP
+#include"string_ref.hpp"
+#include"varint.hpp"
+#include<cstddef>
+#include<map>
+#include<string>
+#include<vector>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+////////////////////////////////////////////////////////////////////////////////
+//  Arena
+////////////////////////////////////////////////////////////////////////////////
+
+// stored strings never move, so references stay valid until clear() or destruction
+class string_arena_t
+{
+    std::vector<char*> chunks;
+    char * next;
+    std::size_t remaining;
+    std::size_t chunk_size;
+
+    // non-copyable
+    string_arena_t(const string_arena_t&);
+    string_arena_t& operator = (const string_arena_t&);
+
+    public:
+
+    explicit string_arena_t(const std::size_t chunk_size_in = 64 * 1024);
+    ~string_arena_t();
+
+    char * allocate(const std::size_t size);
+
+    string_ref_t store(const string_ref_t & str)
+    {
+        if (str.empty())
+        {
+            return string_ref_t();
+        }
+        char * copy = allocate(str.size());
+        std::memcpy(copy, str.data(), str.size());
+        return string_ref_t(copy, str.size());
+    }
+
+    void clear();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/*//////////////////////////////////////////////////////////////////////////////
+
+ Each string is a varint: 0 is followed by a new string as a varint length
+ and its characters, which takes the next index; n refers to the string at
+ index n - 1. Tables are built as they are written and read, so the reads
+ must match the writes in order, and one table covers one save.
+ A writer and reader work with any stream with read/write(char*, size),
+ including std::istream/std::ostream and binary_reader_t/binary_writer_t.
+
+*///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+class string_table_writer_t
+{
+    string_arena_t arena;
+    std::map<string_ref_t, uint64_t> indices;
+
+    // non-copyable
+    string_table_writer_t(const string_table_writer_t&);
+    string_table_writer_t& operator = (const string_table_writer_t&);
+
+    public:
+
+    string_table_writer_t()
+    {
+        // do nothing //
+    }
+
+    template<typename Out>
+    Out& write(Out& out, const string_ref_t & str)
+    {
+        std::map<string_ref_t, uint64_t>::iterator it = indices.lower_bound(str);
+        if (it != indices.end() && it->first == str)
+        {
+            write_varint(out, it->second + 1);
+            return out;
+        }
+
+        const uint64_t index = indices.size();
+        indices.insert(it, std::make_pair(arena.store(str), index));
+
+        write_varint(out, 0);
+        write_varint(out, str.size());
+        out.write(str.data(), str.size());
+        return out;
+    }
+
+    // the number of distinct strings written
+    std::size_t size() const
+    {
+        return indices.size();
+    }
+
+    // forgets every string, to start a new save
+    void clear()
+    {
+        indices.clear();
+        arena.clear();
+    }
+};
+
+// a bad index leaves an empty string and fails the table, see good()
+class string_table_reader_t
+{
+    static const std::size_t long_string_size = 64 * 1024;
+
+    string_arena_t arena;
+    std::vector<string_ref_t> strings;
+    std::string long_string;
+    bool failed;
+
+    template<typename In>
+    bool read_long(In& in, const std::size_t size)
+    {
+        long_string.clear();
+        while (long_string.size() < size)
+        {
+            const std::size_t done = long_string.size();
+            const std::size_t n = size - done < long_string_size? size - done : long_string_size;
+            long_string.resize(done + n);
+            if (!in.read(&long_string[done], n))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // non-copyable
+    string_table_reader_t(const string_table_reader_t&);
+    string_table_reader_t& operator = (const string_table_reader_t&);
+
+    public:
+
+    string_table_reader_t()
+    :   failed(false)
+    {
+        // do nothing //
+    }
+
+    // the reference is valid until the table is cleared or destroyed
+    template<typename In>
+    In& read(In& in, string_ref_t & str)
+    {
+        str = string_ref_t();
+
+        uint64_t code = 0;
+        if (!read_varint(in, code))
+        {
+            return in;
+        }
+        if (code)
+        {
+            if (code > strings.size())
+            {
+                failed = true;
+                return in;
+            }
+            str = strings[code - 1];
+            return in;
+        }
+
+        uint64_t size = 0;
+        if (!read_varint(in, size))
+        {
+            return in;
+        }
+        if (size > 0xFFFFFFFF)
+        {
+            failed = true;
+            return in;
+        }
+
+        // a long string is read in pieces before it is stored, so a corrupt
+        // length runs out of data before it takes the memory
+        if (size > long_string_size)
+        {
+            if (!read_long(in, static_cast<std::size_t>(size)))
+            {
+                return in;
+            }
+            str = arena.store(string_ref_t(long_string.data(), long_string.size()));
+        }
+        else if (size)
+        {
+            char * characters = arena.allocate(static_cast<std::size_t>(size));
+            if (!in.read(characters, static_cast<std::size_t>(size)))
+            {
+                return in;
+            }
+            str = string_ref_t(characters, static_cast<std::size_t>(size));
+        }
+        strings.push_back(str);
+        return in;
+    }
+
+    template<typename In>
+    In& read(In& in, std::string & str)
+    {
+        string_ref_t ref;
+        read(in, ref);
+        str.assign(ref.data(), ref.size());
+        return in;
+    }
+
+    bool good() const
+    {
+        return !failed;
+    }
+
+    // the number of distinct strings read
+    std::size_t size() const
+    {
+        return strings.size();
+    }
+
+    void clear()
+    {
+        strings.clear();
+        arena.clear();
+        failed = false;
+    }
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_STRING_TABLE_HPP
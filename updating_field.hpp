@@ -49,6 +49,7 @@ SOFTWARE.
 #ifndef GAME_DEV_UTILITIES_UPDATING_FIELD_HPP
 #define GAME_DEV_UTILITIES_UPDATING_FIELD_HPP
 #include<types/const.hpp>
+#include"curve_track.hpp"
 #include<cmath>
 namespace game_dev_utilities
 {
@@ -71,7 +72,8 @@ class updating_field_t
 			ATTENUATE,
 			ATTENUATE_BA,
 			ATTENUATE_LINEARLY,
-			ATTENUATE_LINEARLY_BA
+			ATTENUATE_LINEARLY_BA,
+			CURVE // param_A is the time along the curve, param_B the curve id
 		};
 		
 	private:
@@ -153,8 +155,39 @@ class updating_field_t
 		{
 		    set_update_method(ATTENUATE_LINEARLY,target,close_in_value);
 		}
+		// follows a curve from the shared curve library
+		void follow_curve(const curve_library_t::curve_id_t curve, cfloat start_time = 0)
+		{
+		    set_update_method(CURVE,start_time,static_cast<float>(curve));
+		    value = curve_library_t::shared().evaluate(curve, start_time);
+		}
 		
+		// time is the number of whole ticks since the last update; the
+		// default of 0 is taken as a single tick
 		void update(cuint time = 0)
+		{
+			if(time <= 1)
+			{
+				step(update_method, value, param_A, param_B);
+			}
+			else
+			{
+				advance(update_method, value, param_A, param_B, time);
+			}
+		}
+		
+		// Advances by a possibly fractional number of ticks, so fields can be
+		// updated at a lower or variable rate than the tick they were designed
+		// for. Integrating a then b ticks gives the same result as a + b.
+		void integrate(cfloat ticks)
+		{
+			integrate(update_method, value, param_A, param_B, ticks);
+		}
+		
+		// Applies a single tick of the given update method to a value and its
+		// parameters. This is the one definition of each recurrence; anything
+		// that updates fields in bulk should go through here.
+		static void step(const update_method_t update_method, float&value, float&param_A, float&param_B)
 		{
 			switch(update_method)
 			{
@@ -214,22 +247,136 @@ class updating_field_t
                 }
                 case ATTENUATE_LINEARLY:
                 {
-                    value += param_B;
-                    if(std::abs((param_A-value)) < param_B)
+                    if(std::abs(param_A-value) <= std::abs(param_B))
                     {
-                        value = param_B;
+                        value = param_A;
+                    }
+                    else
+                    {
+                        value += param_B;
                     }
                     break;
                 }
                 case ATTENUATE_LINEARLY_BA:
                 {
-                    value += param_A;
-                    if(std::abs((param_B-value)) < param_A)
+                    if(std::abs(param_B-value) <= std::abs(param_A))
                     {
-                        value = param_A;
+                        value = param_B;
+                    }
+                    else
+                    {
+                        value += param_A;
                     }
                     break;
                 }
+				case CURVE:
+				{
+					param_A += 1;
+					value = curve_library_t::shared().evaluate(static_cast<curve_library_t::curve_id_t>(param_B), param_A);
+					break;
+				}
+				case NOTHING:
+				default:
+				{
+					break;
+				}
+			}
+		}
+		
+		// Applies the given number of ticks at once using the closed form of
+		// each recurrence. Agrees with calling step() ticks times up to
+		// floating point rounding.
+		static void advance(const update_method_t update_method, float&value, float&param_A, float&param_B, cuint ticks)
+		{
+			if(ticks <= 1)
+			{
+				if(ticks)
+				{
+					step(update_method, value, param_A, param_B);
+				}
+				return;
+			}
+			
+			integrate(update_method, value, param_A, param_B, static_cast<float>(ticks));
+		}
+		
+		// The closed forms evaluated for any non-negative number of ticks n.
+		// Methods with a negative ratio alternate sign every tick and so are
+		// only defined on whole ticks; for those n is rounded.
+		static void integrate(const update_method_t update_method, float&value, float&param_A, float&param_B, cfloat n)
+		{
+			switch(update_method)
+			{
+				case ADD:
+				{
+					value += n * (param_A + param_B);
+					break;
+				}
+				case ADD_TO_ADD:
+				{
+					value += n * param_A + param_B * n * (n-1) * 0.5f;
+					param_A += n * param_B;
+					break;
+				}
+				case ADD_TO_ADD_BA:
+				{
+					value += n * param_B + param_A * n * (n-1) * 0.5f;
+					param_B += n * param_A;
+					break;
+				}
+				case MULTIPLY_ADD:
+				{
+					value += geometric_sum(param_A, param_B, n);
+					param_A *= power(param_B, n);
+					break;
+				}
+				case MULTIPLY_ADD_BA:
+				{
+					value += geometric_sum(param_B, param_A, n);
+					param_B *= power(param_A, n);
+					break;
+				}
+				case MULTIPLY:
+				{
+					value *= power(param_A, n);
+					break;
+				}
+				case MULTIPLY_BASE:
+				{
+					value = param_B + (value-param_B) * power(param_A, n);
+					break;
+				}
+				case MULTIPLY_BASE_BA:
+				{
+					value = param_A + (value-param_A) * power(param_B, n);
+					break;
+				}
+                case ATTENUATE:
+                {
+                    value = param_A + (value-param_A) * power(1-param_B, n);
+                    break;
+                }
+                case ATTENUATE_BA:
+                {
+                    value = param_B + (value-param_B) * power(1-param_A, n);
+                    break;
+                }
+                case ATTENUATE_LINEARLY:
+                {
+                    value = approach_linearly(value, param_A, param_B, n);
+                    break;
+                }
+                case ATTENUATE_LINEARLY_BA:
+                {
+                    value = approach_linearly(value, param_B, param_A, n);
+                    break;
+                }
+				case CURVE:
+				{
+					param_A += n;
+					value = curve_library_t::shared().evaluate(static_cast<curve_library_t::curve_id_t>(param_B), param_A);
+					break;
+				}
 				case NOTHING:
 				default:
 				{
@@ -237,7 +384,261 @@ class updating_field_t
 				}
 			}
 		}
+		
+		// Whether a field has converged to within tolerance of where its method
+		// would leave it, so that further updates would make no visible
+		// difference. A field that has settled is snapped to its limit.
+		static bool settle(const update_method_t update_method, float&value, cfloat param_A, cfloat param_B, cfloat tolerance)
+		{
+			switch(update_method)
+			{
+				case ADD:
+				{
+					return param_A + param_B == 0;
+				}
+				case ADD_TO_ADD:
+				case ADD_TO_ADD_BA:
+				{
+					return param_A == 0 && param_B == 0;
+				}
+				case MULTIPLY_ADD:
+				{
+					return param_A == 0 || (std::abs(param_B) < 1 && std::abs(param_A) <= tolerance * (1 - std::abs(param_B)));
+				}
+				case MULTIPLY_ADD_BA:
+				{
+					return param_B == 0 || (std::abs(param_A) < 1 && std::abs(param_B) <= tolerance * (1 - std::abs(param_A)));
+				}
+				case MULTIPLY:
+				{
+					return param_A == 1 || value == 0 || (std::abs(param_A) < 1 && converge(value, 0, tolerance));
+				}
+				case MULTIPLY_BASE:
+				{
+					return param_A == 1 || (std::abs(param_A) < 1 && converge(value, param_B, tolerance));
+				}
+				case MULTIPLY_BASE_BA:
+				{
+					return param_B == 1 || (std::abs(param_B) < 1 && converge(value, param_A, tolerance));
+				}
+                case ATTENUATE:
+                {
+                    return param_B == 0 || (param_B > 0 && param_B < 2 && converge(value, param_A, tolerance));
+                }
+                case ATTENUATE_BA:
+                {
+                    return param_A == 0 || (param_A > 0 && param_A < 2 && converge(value, param_B, tolerance));
+                }
+                case ATTENUATE_LINEARLY:
+                {
+                    return param_B == 0 || value == param_A;
+                }
+                case ATTENUATE_LINEARLY_BA:
+                {
+                    return param_A == 0 || value == param_B;
+                }
+				case CURVE:
+				{
+					return param_A >= curve_library_t::shared().end_time(static_cast<curve_library_t::curve_id_t>(param_B));
+				}
+				case NOTHING:
+				default:
+				{
+					return true;
+				}
+			}
+		}
+		
+	private:
 	
+		static bool converge(float&value, cfloat limit, cfloat tolerance)
+		{
+			if(std::abs(value - limit) <= tolerance)
+			{
+				value = limit;
+				return true;
+			}
+			return false;
+		}
+		
+		static float power(cfloat base, cfloat n)
+		{
+			if(base < 0)
+			{
+				return std::pow(base, std::floor(n + 0.5f));
+			}
+			return std::pow(base, n);
+		}
+		
+		// sum of first + first*ratio + ... + first*ratio^(n-1)
+		static float geometric_sum(cfloat first, cfloat ratio, cfloat n)
+		{
+			if(ratio == 1.f)
+			{
+				return first * n;
+			}
+			return first * (1.f - power(ratio, n)) / (1.f - ratio);
+		}
+		
+		// value after n ticks of stepping by 'stride', stopping at the target.
+		// On whole ticks this is the same as stepping, which snaps to the
+		// target on the first tick that starts within one stride of it.
+		static float approach_linearly(cfloat value, cfloat target, cfloat stride, cfloat n)
+		{
+			const float distance = std::abs(target-value);
+			const float stride_length = std::abs(stride);
+			
+			if(n >= 1.f && distance <= stride_length)
+			{
+				return target;
+			}
+			if(stride_length == 0 || (target-value) * stride < 0)
+			{
+				return value + n * stride; // heading away, never arrives
+			}
+			
+			return n * stride_length >= distance ? target : value + n * stride;
+		}
+	
+};
+
+
+/*
+*   A lazily evaluated updating field. Rather than being stepped every tick,
+*   it remembers the tick its current method began and computes its value from
+*   the closed form when read. Fields that are never read cost nothing, and
+*   there is no per-frame update pass: the game advances the shared clock once.
+*
+*   Ticks are measured by lazy_updating_field_t::tick(), which the owner of the
+*   simulation advances alongside its fixed update. Reading a field at a tick
+*   before it was last set is not meaningful.
+*/
+class lazy_updating_field_t
+{
+	public:
+	
+		typedef updating_field_t::update_method_t update_method_t;
+		
+	private:
+	
+		float start_value;
+		float param_A;
+		float param_B;
+		update_method_t update_method;
+		unsigned int start_tick;
+		
+		// brings the start state forward to the current tick so that the
+		// method or value can be changed from here on
+		void rebase()
+		{
+			const unsigned int now = current_tick();
+			updating_field_t::advance(update_method, start_value, param_A, param_B, now - start_tick);
+			start_tick = now;
+		}
+	
+	public:
+	
+		explicit lazy_updating_field_t(cfloat value_in = 0):
+			start_value(value_in),
+			param_A(0),
+			param_B(0),
+			update_method(updating_field_t::NOTHING),
+			start_tick(current_tick())
+		{
+			// do nothing //
+		}
+		
+		// the shared simulation clock all lazy fields are evaluated against
+		static unsigned int& current_tick()
+		{
+			static unsigned int ticks = 0;
+			return ticks;
+		}
+		
+		static void tick(cuint ticks = 1)
+		{
+			current_tick() += ticks;
+		}
+		
+		float value_at(cuint tick) const
+		{
+			float value = start_value;
+			float A = param_A;
+			float B = param_B;
+			updating_field_t::advance(update_method, value, A, B, tick - start_tick);
+			return value;
+		}
+		
+		void set_value(cfloat value_in)
+		{
+			rebase();
+			start_value = value_in;
+		}
+		
+		void set_update_method(const update_method_t update_method_in, cfloat param_A_in, cfloat param_B_in = 0)
+		{
+			rebase();
+			update_method = update_method_in;
+			param_A = param_A_in;
+			param_B = param_B_in;
+		}
+		
+		operator float() const
+		{
+			return value_at(current_tick());
+		}
+		
+		float operator = (cfloat value_in)
+		{
+			set_value(value_in);
+			return start_value;
+		}
+		
+		float operator += (cfloat value_in)
+		{
+			rebase();
+			return start_value += value_in;
+		}
+		
+		float operator -= (cfloat value_in)
+		{
+			rebase();
+			return start_value -= value_in;
+		}
+		
+		void add(cfloat inc)
+		{
+		    set_update_method(updating_field_t::ADD,inc);
+		}
+		void add_by_A_compound_add_by_B(cfloat A, cfloat B)
+		{
+		    set_update_method(updating_field_t::ADD_TO_ADD,A,B);
+		}
+		void inc_by_A_compound_multiplied_by_B(cfloat A, cfloat B)
+		{
+		    set_update_method(updating_field_t::MULTIPLY_ADD,A,B);
+		}
+		void multiply(cfloat A)
+		{
+		    set_update_method(updating_field_t::MULTIPLY,A);
+		}
+		void multiply_base(cfloat base_value, cfloat multiplier)
+		{
+		    set_update_method(updating_field_t::MULTIPLY_BASE, multiplier, base_value);
+		}
+		void attenuate(cfloat target, cfloat close_in_ratio)
+		{
+		    set_update_method(updating_field_t::ATTENUATE,target,close_in_ratio);
+		}
+		void attenuate_linearly(cfloat target, cfloat close_in_value)
+		{
+		    set_update_method(updating_field_t::ATTENUATE_LINEARLY,target,close_in_value);
+		}
+		void follow_curve(const curve_library_t::curve_id_t curve, cfloat start_time = 0)
+		{
+		    set_update_method(updating_field_t::CURVE,start_time,static_cast<float>(curve));
+		    start_value = curve_library_t::shared().evaluate(curve, start_time);
+		}
 };
 
 
@@ -0,0 +1,322 @@
+/*
+*
+*	updating_field_history.hpp
+*
+*   Saves and restores the complete state of an updating field pool each
+*   tick, for rolling back and resimulating as in rollback netcode.
+*
+*   Frames are kept in a ring of preallocated buffers; saving a frame copies
+*   each of the pool's arrays in one block and restoring copies them back.
+*
+*   Optionally, older frames can be held only as the XOR of each frame with
+*   the one after it, with runs of unchanged words collapsed. Between ticks
+*   most of a pool is either asleep or changing in its low bits, so this keeps
+*   a long history in little memory; rolling back applies one delta per frame
+*   to the newest full frame.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_UPDATING_FIELD_HISTORY_HPP
+#define GAME_DEV_UTILITIES_UPDATING_FIELD_HISTORY_HPP
+#include"updating_field_pool.hpp"
+#include<vector>
+#include<cstring>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+class updating_field_history_t
+{
+	private:
+	
+		typedef std::vector<uint32_t> frame_t;
+		
+		std::vector<frame_t> frames; // full frames, or deltas when compressing
+		frame_t latest;              // the newest frame, when compressing
+		frame_t scratch;
+		std::size_t newest;          // ring position of the newest frame
+		std::size_t count;           // frames held
+		bool delta_compression;
+		
+		// Frame layout, in 32 bit words: field count, active count, trigger
+		// count, link count, then the values, param_As, param_Bs, thresholds,
+		// slot_of and handle_of arrays, then the methods and the trigger modes
+		// each packed four to a word, then each link's target, source and
+		// param. The links are kept so that a restore never leaves one to a
+		// field added since.
+		static std::size_t packed_words(const std::size_t fields)
+		{
+			return (fields + 3) / 4;
+		}
+		
+		static std::size_t frame_words(const std::size_t fields, const std::size_t links = 0)
+		{
+			return 4 + 6 * fields + 2 * packed_words(fields) + 3 * links;
+		}
+		
+		template<typename V>
+		static uint32_t * copy_out(uint32_t * out, const V & array)
+		{
+			if(!array.empty())
+			{
+				std::memcpy(out, &array[0], array.size() * sizeof(array[0]));
+			}
+			return out + (array.size() * sizeof(array[0]) + 3) / 4;
+		}
+		
+		template<typename V>
+		static const uint32_t * copy_in(const uint32_t * in, V & array, const std::size_t fields)
+		{
+			array.resize(fields);
+			if(fields)
+			{
+				std::memcpy(&array[0], in, fields * sizeof(array[0]));
+			}
+			return in + (fields * sizeof(array[0]) + 3) / 4;
+		}
+		
+		static void capture(const updating_field_pool_t & pool, frame_t & frame)
+		{
+			const std::size_t fields = pool.size();
+			const std::size_t links = pool.links.size();
+			frame.resize(frame_words(fields, links));
+			const std::size_t packed_end = frame_words(fields);
+			frame[packed_end - 1] = 0; // padding of the packed modes
+			frame[packed_end - 1 - packed_words(fields)] = 0; // and methods
+			
+			uint32_t * out = &frame[0];
+			*out++ = static_cast<uint32_t>(fields);
+			*out++ = static_cast<uint32_t>(pool.active_count);
+			*out++ = static_cast<uint32_t>(pool.trigger_count);
+			*out++ = static_cast<uint32_t>(links);
+			out = copy_out(out, pool.values);
+			out = copy_out(out, pool.param_As);
+			out = copy_out(out, pool.param_Bs);
+			out = copy_out(out, pool.thresholds);
+			out = copy_out(out, pool.slot_of);
+			out = copy_out(out, pool.handle_of);
+			out = copy_out(out, pool.update_methods);
+			out = copy_out(out, pool.trigger_modes);
+			for(std::size_t l = 0; l < links; ++l)
+			{
+				*out++ = pool.links[l].target;
+				*out++ = pool.links[l].source;
+				*out++ = pool.links[l].param;
+			}
+		}
+		
+		static void apply(const frame_t & frame, updating_field_pool_t & pool)
+		{
+			const uint32_t * in = &frame[0];
+			const std::size_t fields = *in++;
+			pool.active_count = *in++;
+			pool.trigger_count = *in++;
+			const std::size_t links = *in++;
+			in = copy_in(in, pool.values, fields);
+			in = copy_in(in, pool.param_As, fields);
+			in = copy_in(in, pool.param_Bs, fields);
+			in = copy_in(in, pool.thresholds, fields);
+			in = copy_in(in, pool.slot_of, fields);
+			in = copy_in(in, pool.handle_of, fields);
+			in = copy_in(in, pool.update_methods, fields);
+			in = copy_in(in, pool.trigger_modes, fields);
+			pool.links.resize(links);
+			for(std::size_t l = 0; l < links; ++l)
+			{
+				pool.links[l].target = *in++;
+				pool.links[l].source = *in++;
+				pool.links[l].param = static_cast<uint8_t>(*in++);
+				pool.links[l].target_slot = 0;
+			}
+			pool.triggered_handles.clear();
+			pool.links_dirty = true; // the linked fields are put back in place
+		}
+		
+		// Encodes older ^ newer as the length of older followed by pairs of
+		// (unchanged words to skip, changed words to follow) and the changed
+		// words themselves. The shorter frame is taken as padded with zeros.
+		static void encode_delta(const frame_t & older, const frame_t & newer, frame_t & delta)
+		{
+			const std::size_t length = std::max(older.size(), newer.size());
+			delta.clear();
+			delta.push_back(static_cast<uint32_t>(older.size()));
+			
+			std::size_t w = 0;
+			while(w < length)
+			{
+				const std::size_t skip_start = w;
+				while(w < length && word(older, w) == word(newer, w))
+				{
+					++w;
+				}
+				const std::size_t change_start = w;
+				while(w < length && word(older, w) != word(newer, w))
+				{
+					++w;
+				}
+				if(change_start == w)
+				{
+					break;
+				}
+				
+				delta.push_back(static_cast<uint32_t>(change_start - skip_start));
+				delta.push_back(static_cast<uint32_t>(w - change_start));
+				for(std::size_t c = change_start; c < w; ++c)
+				{
+					delta.push_back(word(older, c) ^ word(newer, c));
+				}
+			}
+		}
+		
+		// turns a frame into the frame before it
+		static void decode_delta(const frame_t & delta, frame_t & frame)
+		{
+			const std::size_t older_size = delta[0];
+			frame.resize(std::max(frame.size(), older_size), 0);
+			
+			std::size_t w = 0;
+			for(std::size_t d = 1; d < delta.size();)
+			{
+				w += delta[d++];
+				const std::size_t changed = delta[d++];
+				for(std::size_t c = 0; c < changed; ++c)
+				{
+					frame[w++] ^= delta[d++];
+				}
+			}
+			frame.resize(older_size);
+		}
+		
+		static uint32_t word(const frame_t & frame, const std::size_t w)
+		{
+			return w < frame.size() ? frame[w] : 0;
+		}
+		
+		std::size_t ring_index(const std::size_t frames_back) const
+		{
+			return (newest + frames.size() - frames_back) % frames.size();
+		}
+		
+	public:
+	
+		// Keeps up to frame_count frames. With delta compression, all but the
+		// newest are kept as deltas.
+		explicit updating_field_history_t(const std::size_t frame_count, const bool delta_compression_in = false):
+			frames(delta_compression_in ? (frame_count > 1 ? frame_count - 1 : 1) : (frame_count ? frame_count : 1)),
+			newest(0),
+			count(0),
+			delta_compression(delta_compression_in)
+		{
+			// do nothing //
+		}
+		
+		// preallocates buffers for pools of up to the given number of fields
+		void reserve(const std::size_t fields)
+		{
+			for(std::vector<frame_t>::iterator itr = frames.begin(); itr != frames.end(); ++itr)
+			{
+				itr->reserve(frame_words(fields));
+			}
+			latest.reserve(frame_words(fields));
+			scratch.reserve(frame_words(fields));
+		}
+		
+		// the number of frames that can be restored
+		std::size_t size() const
+		{
+			return count;
+		}
+		
+		std::size_t capacity() const
+		{
+			return delta_compression ? frames.size() + 1 : frames.size();
+		}
+		
+		void clear()
+		{
+			count = 0;
+		}
+		
+		void save(const updating_field_pool_t & pool)
+		{
+			if(!delta_compression)
+			{
+				newest = (newest + 1) % frames.size();
+				capture(pool, frames[newest]);
+				count = std::min(count + 1, frames.size());
+				return;
+			}
+			
+			if(count == 0)
+			{
+				capture(pool, latest);
+				count = 1;
+				return;
+			}
+			
+			capture(pool, scratch);
+			newest = (newest + 1) % frames.size();
+			encode_delta(latest, scratch, frames[newest]);
+			latest.swap(scratch);
+			count = std::min(count + 1, capacity());
+		}
+		
+		// Restores the pool to the frame saved frames_back saves before the
+		// newest, which becomes the newest frame; later frames are dropped.
+		// Returns false if that frame is no longer held.
+		bool restore(updating_field_pool_t & pool, const std::size_t frames_back = 0)
+		{
+			if(frames_back >= count)
+			{
+				return false;
+			}
+			
+			if(!delta_compression)
+			{
+				newest = ring_index(frames_back);
+				apply(frames[newest], pool);
+				count -= frames_back;
+				return true;
+			}
+			
+			for(std::size_t f = 0; f < frames_back; ++f)
+			{
+				decode_delta(frames[newest], latest);
+				newest = ring_index(1);
+			}
+			apply(latest, pool);
+			count -= frames_back;
+			return true;
+		}
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_UPDATING_FIELD_HISTORY_HPP
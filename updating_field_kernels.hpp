@@ -0,0 +1,269 @@
+/*
+*
+*	updating_field_kernels.hpp
+*
+*   Bulk forms of the updating field methods for fields stored as separate
+*   arrays of values and parameters. Where consecutive fields share a method
+*   they are updated as one run, four floats at a time with SSE2 where it is
+*   available. The arithmetic is the same as updating_field_t::step, in the
+*   same order, so bulk and single updates agree exactly. Runs of fields
+*   following curves are evaluated grouped by curve.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_UPDATING_FIELD_KERNELS_HPP
+#define GAME_DEV_UTILITIES_UPDATING_FIELD_KERNELS_HPP
+#include"updating_field.hpp"
+#include<cstddef>
+#include<cstring>
+#include<vector>
+#include<stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAME_DEV_UTILITIES_SSE2
+#include<emmintrin.h>
+#endif
+
+namespace game_dev_utilities
+{
+namespace updating_field_kernels
+{
+
+typedef updating_field_t::update_method_t update_method_t;
+
+#ifdef GAME_DEV_UTILITIES_SSE2
+
+// |a - b| <= |c| ? a : b + c, lane by lane
+inline __m128 approach_linearly(const __m128 target, const __m128 value, const __m128 stride)
+{
+    const __m128 magnitude = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 arrived = _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(target, value), magnitude), _mm_and_ps(stride, magnitude));
+    return _mm_or_ps(_mm_and_ps(arrived, target), _mm_andnot_ps(arrived, _mm_add_ps(value, stride)));
+}
+
+// One tick of each method on four lanes; changes_A/changes_B say which
+// parameters the method writes back.
+template<update_method_t Method>
+struct sse_step;
+
+#define GAME_DEV_UTILITIES_SSE_STEP(METHOD, CHANGES_A, CHANGES_B, BODY) \
+    template<> \
+    struct sse_step<updating_field_t::METHOD> \
+    { \
+        static const bool changes_A = CHANGES_A; \
+        static const bool changes_B = CHANGES_B; \
+        static void apply(__m128&value, __m128&A, __m128&B) \
+        { \
+            BODY; \
+        } \
+    };
+
+GAME_DEV_UTILITIES_SSE_STEP(ADD, false, false, value = _mm_add_ps(value, _mm_add_ps(A, B)))
+GAME_DEV_UTILITIES_SSE_STEP(ADD_TO_ADD, true, false, value = _mm_add_ps(value, A); A = _mm_add_ps(A, B))
+GAME_DEV_UTILITIES_SSE_STEP(ADD_TO_ADD_BA, false, true, value = _mm_add_ps(value, B); B = _mm_add_ps(B, A))
+GAME_DEV_UTILITIES_SSE_STEP(MULTIPLY_ADD, true, false, value = _mm_add_ps(value, A); A = _mm_mul_ps(A, B))
+GAME_DEV_UTILITIES_SSE_STEP(MULTIPLY_ADD_BA, false, true, value = _mm_add_ps(value, B); B = _mm_mul_ps(B, A))
+GAME_DEV_UTILITIES_SSE_STEP(MULTIPLY, false, false, value = _mm_mul_ps(value, A); (void)B)
+GAME_DEV_UTILITIES_SSE_STEP(MULTIPLY_BASE, false, false, value = _mm_add_ps(B, _mm_mul_ps(_mm_sub_ps(value, B), A)))
+GAME_DEV_UTILITIES_SSE_STEP(MULTIPLY_BASE_BA, false, false, value = _mm_add_ps(A, _mm_mul_ps(_mm_sub_ps(value, A), B)))
+GAME_DEV_UTILITIES_SSE_STEP(ATTENUATE, false, false, value = _mm_add_ps(value, _mm_mul_ps(_mm_sub_ps(A, value), B)))
+GAME_DEV_UTILITIES_SSE_STEP(ATTENUATE_BA, false, false, value = _mm_add_ps(value, _mm_mul_ps(_mm_sub_ps(B, value), A)))
+GAME_DEV_UTILITIES_SSE_STEP(ATTENUATE_LINEARLY, false, false, value = approach_linearly(A, value, B))
+GAME_DEV_UTILITIES_SSE_STEP(ATTENUATE_LINEARLY_BA, false, false, value = approach_linearly(B, value, A))
+
+#undef GAME_DEV_UTILITIES_SSE_STEP
+
+template<update_method_t Method>
+inline std::size_t sse_loop(float * v, float * a, float * b, const std::size_t count)
+{
+    const std::size_t wide = count & ~static_cast<std::size_t>(3);
+
+    for (std::size_t i = 0; i < wide; i += 4)
+    {
+        __m128 value = _mm_loadu_ps(v + i);
+        __m128 A = _mm_loadu_ps(a + i);
+        __m128 B = _mm_loadu_ps(b + i);
+
+        sse_step<Method>::apply(value, A, B);
+
+        _mm_storeu_ps(v + i, value);
+        if (sse_step<Method>::changes_A)
+        {
+            _mm_storeu_ps(a + i, A);
+        }
+        if (sse_step<Method>::changes_B)
+        {
+            _mm_storeu_ps(b + i, B);
+        }
+    }
+
+    return wide;
+}
+
+// Updates count floats sharing one method, returning how many were done; the
+// remainder (fewer than four) is left for the scalar loop.
+inline std::size_t update_run_sse(const update_method_t method, float * v, float * a, float * b, const std::size_t count)
+{
+    switch (method)
+    {
+        case updating_field_t::ADD: return sse_loop<updating_field_t::ADD>(v, a, b, count);
+        case updating_field_t::ADD_TO_ADD: return sse_loop<updating_field_t::ADD_TO_ADD>(v, a, b, count);
+        case updating_field_t::ADD_TO_ADD_BA: return sse_loop<updating_field_t::ADD_TO_ADD_BA>(v, a, b, count);
+        case updating_field_t::MULTIPLY_ADD: return sse_loop<updating_field_t::MULTIPLY_ADD>(v, a, b, count);
+        case updating_field_t::MULTIPLY_ADD_BA: return sse_loop<updating_field_t::MULTIPLY_ADD_BA>(v, a, b, count);
+        case updating_field_t::MULTIPLY: return sse_loop<updating_field_t::MULTIPLY>(v, a, b, count);
+        case updating_field_t::MULTIPLY_BASE: return sse_loop<updating_field_t::MULTIPLY_BASE>(v, a, b, count);
+        case updating_field_t::MULTIPLY_BASE_BA: return sse_loop<updating_field_t::MULTIPLY_BASE_BA>(v, a, b, count);
+        case updating_field_t::ATTENUATE: return sse_loop<updating_field_t::ATTENUATE>(v, a, b, count);
+        case updating_field_t::ATTENUATE_BA: return sse_loop<updating_field_t::ATTENUATE_BA>(v, a, b, count);
+        case updating_field_t::ATTENUATE_LINEARLY: return sse_loop<updating_field_t::ATTENUATE_LINEARLY>(v, a, b, count);
+        case updating_field_t::ATTENUATE_LINEARLY_BA: return sse_loop<updating_field_t::ATTENUATE_LINEARLY_BA>(v, a, b, count);
+        case updating_field_t::NOTHING:
+            return count;
+        default:
+            return 0;
+    }
+}
+
+#endif // GAME_DEV_UTILITIES_SSE2
+
+// Updates count consecutive floats which all use the same method.
+inline void update_run(const update_method_t method, float * values, float * param_As, float * param_Bs, const std::size_t count)
+{
+    if (method == updating_field_t::CURVE)
+    {
+        curve_library_t::shared().step(values, param_As, param_Bs, count);
+        return;
+    }
+
+    std::size_t done = 0;
+
+    #ifdef GAME_DEV_UTILITIES_SSE2
+    done = update_run_sse(method, values, param_As, param_Bs, count);
+    #endif
+
+    for (std::size_t i = done; i < count; ++i)
+    {
+        updating_field_t::step(method, values[i], param_As[i], param_Bs[i]);
+    }
+}
+
+// Updates count fields, each of which has one method and 'lanes' consecutive
+// floats in each of the value and parameter arrays; a 2D field has two lanes.
+// Consecutive fields with the same method are updated as a single run.
+inline void update_span(const uint8_t * methods, float * values, float * param_As, float * param_Bs, const std::size_t count, const std::size_t lanes = 1)
+{
+    std::size_t begin = 0;
+
+    while (begin < count)
+    {
+        std::size_t end = begin + 1;
+        while (end < count && methods[end] == methods[begin])
+        {
+            ++end;
+        }
+
+        const std::size_t offset = begin * lanes;
+        update_run(static_cast<update_method_t>(methods[begin]), values + offset, param_As + offset, param_Bs + offset, (end - begin) * lanes);
+
+        begin = end;
+    }
+}
+
+
+// Trigger modes for find_crossings, which may be combined.
+enum crossing_t
+{
+    NO_CROSSING = 0,
+    RISING = 1,  // fires when a value reaches the threshold from below
+    FALLING = 2  // fires when a value reaches the threshold from above
+};
+
+inline bool crossed(const float before, const float after, const float threshold, const uint8_t mode)
+{
+    return ((mode & RISING) && before < threshold && after >= threshold)
+        || ((mode & FALLING) && before > threshold && after <= threshold);
+}
+
+// Appends to 'fired' the index of every field whose value crossed its
+// threshold in a direction its mode watches for, going from before to after.
+inline void find_crossings(const float * before, const float * after, const float * thresholds, const uint8_t * modes,
+    const std::size_t count, std::vector<unsigned int> & fired)
+{
+    std::size_t i = 0;
+
+    #ifdef GAME_DEV_UTILITIES_SSE2
+    const __m128i rising = _mm_set1_epi32(RISING);
+    const __m128i falling = _mm_set1_epi32(FALLING);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        int packed_modes;
+        std::memcpy(&packed_modes, modes + i, sizeof(packed_modes));
+        if (!packed_modes)
+        {
+            continue;
+        }
+
+        const __m128i mode = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed_modes), zero), zero);
+        const __m128 watch_rise = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(mode, rising), rising));
+        const __m128 watch_fall = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(mode, falling), falling));
+
+        const __m128 b = _mm_loadu_ps(before + i);
+        const __m128 a = _mm_loadu_ps(after + i);
+        const __m128 t = _mm_loadu_ps(thresholds + i);
+
+        const __m128 rose = _mm_and_ps(_mm_cmplt_ps(b, t), _mm_cmpge_ps(a, t));
+        const __m128 fell = _mm_and_ps(_mm_cmpgt_ps(b, t), _mm_cmple_ps(a, t));
+
+        int mask = _mm_movemask_ps(_mm_or_ps(_mm_and_ps(rose, watch_rise), _mm_and_ps(fell, watch_fall)));
+        for (unsigned int lane = 0; mask; ++lane, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                fired.push_back(static_cast<unsigned int>(i + lane));
+            }
+        }
+    }
+    #endif
+
+    for (; i < count; ++i)
+    {
+        if (crossed(before[i], after[i], thresholds[i], modes[i]))
+        {
+            fired.push_back(static_cast<unsigned int>(i));
+        }
+    }
+}
+
+} // namespace updating_field_kernels
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_UPDATING_FIELD_KERNELS_HPP
@@ -0,0 +1,590 @@
+/*
+*
+*	updating_field_pool.hpp
+*
+*   A contiguous pool of updating fields stored as separate arrays of values,
+*   parameters and update methods. Updating fields in bulk from a pool touches
+*   only the memory being updated, and the storage can be split into chunks
+*   and updated across several threads.
+*
+*   A field's parameter can be linked to another field's value, such as a
+*   position taking its increment from an attenuating speed. Linked fields are
+*   updated in batches by dependency level, after the fields feeding them.
+*
+*   Fields which settle on their target are moved out of the updated range
+*   until they are next changed, so the cost of an update follows the number
+*   of fields still moving.
+*
+*   Fields are updated with the bulk kernels, which use the same arithmetic as
+*   updating_field_t::step, so a pool gives exactly the same results as the
+*   equivalent updating_field_t objects, whether it is updated on one thread or
+*   many. The exception is settling, which snaps a field to its limit once it
+*   is within the settle tolerance; a negative tolerance turns this off.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_UPDATING_FIELD_POOL_HPP
+#define GAME_DEV_UTILITIES_UPDATING_FIELD_POOL_HPP
+#include"updating_field.hpp"
+#include"updating_field_kernels.hpp"
+#include"aligned_allocator.hpp"
+#include"worker_pool.hpp"
+#include<vector>
+#include<algorithm>
+#include<utility>
+#include<stdexcept>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+class updating_field_pool_t
+{
+	public:
+	
+		typedef updating_field_t::update_method_t update_method_t;
+		typedef unsigned int handle_t;
+		
+		// Fields per job when updating in parallel. A multiple of the cache
+		// line size, so with cache line aligned arrays no two jobs ever write
+		// to the same line of any array.
+		static const std::size_t chunk_size = 16 * cache_line_size;
+		
+	private:
+	
+		friend class updating_field_history_t;
+		
+		std::vector<float, aligned_allocator<float> > values;
+		std::vector<float, aligned_allocator<float> > param_As;
+		std::vector<float, aligned_allocator<float> > param_Bs;
+		std::vector<uint8_t, aligned_allocator<uint8_t> > update_methods;
+		
+		// Slots below active_count are updated; the rest have settled and
+		// sleep until their value or method is next set. Handles stay fixed
+		// while fields move between slots.
+		std::vector<unsigned int> slot_of;
+		std::vector<handle_t> handle_of;
+		std::size_t active_count;
+		float settle_tolerance;
+		
+		// Threshold triggers, checked after each update while any are set.
+		// The values before the update are kept in previous_values for that.
+		std::vector<float, aligned_allocator<float> > thresholds;
+		std::vector<uint8_t, aligned_allocator<uint8_t> > trigger_modes;
+		std::vector<float, aligned_allocator<float> > previous_values;
+		std::size_t trigger_count;
+		std::vector<unsigned int> fired_slots;
+		std::vector<handle_t> triggered_handles;
+		
+		// Links feed the value of one field into a parameter of another.
+		// Linked fields occupy the first linked_count slots, grouped by level:
+		// a field's level is one more than the highest level of the fields
+		// feeding it, unlinked fields being level 0. Each level is updated as
+		// a batch after the one before it.
+		struct link_t
+		{
+			handle_t target;
+			handle_t source;
+			uint8_t param; // link_param_t
+			unsigned int target_slot;
+		};
+		std::vector<link_t> links;         // ordered by the level of their target
+		std::vector<std::size_t> level_ends;      // end slot of each linked level
+		std::vector<std::size_t> level_link_ends; // end of each level's links
+		std::size_t linked_count;
+		bool links_dirty;
+		
+		void update_range(const std::size_t begin, const std::size_t end)
+		{
+			updating_field_kernels::update_span(&update_methods[begin], &values[begin], &param_As[begin], &param_Bs[begin], end - begin);
+		}
+		
+		void integrate_range(const std::size_t begin, const std::size_t end, cfloat ticks)
+		{
+			for(std::size_t f = begin; f < end; ++f)
+			{
+				updating_field_t::integrate(static_cast<update_method_t>(update_methods[f]), values[f], param_As[f], param_Bs[f], ticks);
+			}
+		}
+		
+		// A ticks of 1 steps the fields, otherwise they are integrated. Chunks
+		// are counted from slot 0 so that their bounds stay on cache lines
+		// wherever the range starts.
+		struct chunk_job_t
+		{
+			updating_field_pool_t * pool;
+			float ticks;
+			std::size_t begin;
+			std::size_t end;
+			
+			void operator()(const std::size_t chunk)
+			{
+				const std::size_t first = (begin / chunk_size + chunk) * chunk_size;
+				const std::size_t chunk_begin = std::max(first, begin);
+				const std::size_t chunk_end = std::min(first + chunk_size, end);
+				pool->advance_range(chunk_begin, chunk_end, ticks);
+			}
+		};
+		
+		void advance_range(const std::size_t begin, const std::size_t end, cfloat ticks)
+		{
+			if(begin >= end)
+			{
+				return;
+			}
+			if(ticks == 1.f)
+			{
+				update_range(begin, end);
+			}
+			else
+			{
+				integrate_range(begin, end, ticks);
+			}
+		}
+		
+		void advance_range(const std::size_t begin, const std::size_t end, cfloat ticks, worker_pool_t * workers)
+		{
+			if(!workers || end <= begin + chunk_size || workers->size() == 1)
+			{
+				advance_range(begin, end, ticks);
+				return;
+			}
+			
+			chunk_job_t job = {this, ticks, begin, end};
+			workers->run((end - 1) / chunk_size - begin / chunk_size + 1, job);
+		}
+		
+		// updates the unlinked fields, then each level of linked fields in
+		// turn once the values feeding them are up to date
+		void advance(cfloat ticks, worker_pool_t * workers)
+		{
+			if(links_dirty)
+			{
+				arrange_links();
+			}
+			
+			begin_update();
+			advance_range(linked_count, active_count, ticks, workers);
+			
+			std::size_t level_begin = 0;
+			std::size_t link = 0;
+			for(std::size_t level = 0; level < level_ends.size(); ++level)
+			{
+				for(; link < level_link_ends[level]; ++link)
+				{
+					const link_t & l = links[link];
+					(l.param == LINK_PARAM_A ? param_As : param_Bs)[l.target_slot] = values[slot_of[l.source]];
+				}
+				advance_range(level_begin, level_ends[level], ticks, workers);
+				level_begin = level_ends[level];
+			}
+			
+			end_update();
+		}
+		
+		// Works out the level of every linked field and moves the linked
+		// fields into the leading slots, lowest level first. Linked fields are
+		// kept awake, as their parameters may change every tick.
+		void arrange_links()
+		{
+			links_dirty = false;
+			
+			std::vector<unsigned int> level(size(), 0);
+			for(bool changed = true; changed;)
+			{
+				changed = false;
+				for(std::vector<link_t>::const_iterator itr = links.begin(); itr != links.end(); ++itr)
+				{
+					if(level[itr->target] < level[itr->source] + 1)
+					{
+						level[itr->target] = level[itr->source] + 1;
+						changed = true;
+					}
+				}
+			}
+			
+			std::vector<std::pair<unsigned int, handle_t> > linked;
+			for(std::vector<link_t>::const_iterator itr = links.begin(); itr != links.end(); ++itr)
+			{
+				linked.push_back(std::make_pair(level[itr->target], itr->target));
+			}
+			std::sort(linked.begin(), linked.end());
+			linked.erase(std::unique(linked.begin(), linked.end()), linked.end());
+			
+			level_ends.clear();
+			for(std::size_t i = 0; i < linked.size(); ++i)
+			{
+				const handle_t field = linked[i].second;
+				wake(slot_of[field]);
+				swap_slots(i, slot_of[field]);
+				
+				if(level_ends.size() < linked[i].first)
+				{
+					level_ends.resize(linked[i].first, i);
+				}
+				level_ends.back() = i + 1;
+			}
+			linked_count = linked.size();
+			
+			for(std::vector<link_t>::iterator itr = links.begin(); itr != links.end(); ++itr)
+			{
+				itr->target_slot = slot_of[itr->target];
+			}
+			std::sort(links.begin(), links.end(), link_slot_less);
+			
+			level_link_ends.assign(level_ends.size(), 0);
+			std::size_t link = 0;
+			for(std::size_t l = 0; l < level_ends.size(); ++l)
+			{
+				while(link < links.size() && links[link].target_slot < level_ends[l])
+				{
+					++link;
+				}
+				level_link_ends[l] = link;
+			}
+		}
+		
+		static bool link_slot_less(const link_t & a, const link_t & b)
+		{
+			return a.target_slot < b.target_slot;
+		}
+		
+		// whether 'from' already depends, through links, on 'to'
+		bool depends_on(const handle_t from, const handle_t to) const
+		{
+			std::vector<handle_t> open(1, from);
+			std::vector<bool> seen(size(), false);
+			while(!open.empty())
+			{
+				const handle_t field = open.back();
+				open.pop_back();
+				if(field == to)
+				{
+					return true;
+				}
+				for(std::vector<link_t>::const_iterator itr = links.begin(); itr != links.end(); ++itr)
+				{
+					if(itr->target == field && !seen[itr->source])
+					{
+						seen[itr->source] = true;
+						open.push_back(itr->source);
+					}
+				}
+			}
+			return false;
+		}
+		
+		void swap_slots(const std::size_t a, const std::size_t b)
+		{
+			if(a == b)
+			{
+				return;
+			}
+			std::swap(values[a], values[b]);
+			std::swap(param_As[a], param_As[b]);
+			std::swap(param_Bs[a], param_Bs[b]);
+			std::swap(update_methods[a], update_methods[b]);
+			std::swap(thresholds[a], thresholds[b]);
+			std::swap(trigger_modes[a], trigger_modes[b]);
+			std::swap(handle_of[a], handle_of[b]);
+			slot_of[handle_of[a]] = static_cast<unsigned int>(a);
+			slot_of[handle_of[b]] = static_cast<unsigned int>(b);
+		}
+		
+		void wake(const std::size_t slot)
+		{
+			if(slot >= active_count)
+			{
+				swap_slots(slot, active_count);
+				++active_count;
+			}
+		}
+		
+		void begin_update()
+		{
+			triggered_handles.clear();
+			if(trigger_count && active_count)
+			{
+				previous_values.assign(values.begin(), values.begin() + active_count);
+			}
+		}
+		
+		// checks triggers, then retires settled fields
+		void end_update()
+		{
+			if(trigger_count && active_count)
+			{
+				fired_slots.clear();
+				updating_field_kernels::find_crossings(&previous_values[0], &values[0], &thresholds[0], &trigger_modes[0], active_count, fired_slots);
+				for(std::vector<unsigned int>::const_iterator itr = fired_slots.begin(); itr != fired_slots.end(); ++itr)
+				{
+					triggered_handles.push_back(handle_of[*itr]);
+				}
+			}
+			retire_settled();
+		}
+		
+		// moves fields that have settled out of the active slots; the cost
+		// is proportional to the number of fields still moving. Settling snaps
+		// a field to its target, so that last step is checked for a crossing
+		// too - a trigger at the target of a fade fires when the fade ends
+		void retire_settled()
+		{
+			if(settle_tolerance < 0)
+			{
+				return;
+			}
+			
+			for(std::size_t slot = linked_count; slot < active_count;)
+			{
+				const float before = values[slot];
+				if(updating_field_t::settle(static_cast<update_method_t>(update_methods[slot]), values[slot], param_As[slot], param_Bs[slot], settle_tolerance))
+				{
+					if(trigger_count && updating_field_kernels::crossed(before, values[slot], thresholds[slot], trigger_modes[slot]))
+					{
+						triggered_handles.push_back(handle_of[slot]);
+					}
+					
+					--active_count;
+					swap_slots(slot, active_count);
+				}
+				else
+				{
+					++slot;
+				}
+			}
+		}
+		
+	public:
+	
+		typedef updating_field_kernels::crossing_t crossing_t;
+		
+		enum link_param_t
+		{
+			LINK_PARAM_A,
+			LINK_PARAM_B
+		};
+		
+		updating_field_pool_t():
+			active_count(0),
+			settle_tolerance(1e-5f),
+			trigger_count(0),
+			linked_count(0),
+			links_dirty(false)
+		{
+			// do nothing //
+		}
+	
+		handle_t add(cfloat value_in, const update_method_t update_method_in = updating_field_t::NOTHING, cfloat param_A_in = 0, cfloat param_B_in = 0)
+		{
+			const handle_t handle = static_cast<handle_t>(values.size());
+			
+			values.push_back(value_in);
+			param_As.push_back(param_A_in);
+			param_Bs.push_back(param_B_in);
+			update_methods.push_back(static_cast<uint8_t>(update_method_in));
+			thresholds.push_back(0);
+			trigger_modes.push_back(updating_field_kernels::NO_CROSSING);
+			slot_of.push_back(handle);
+			handle_of.push_back(handle);
+			
+			wake(handle);
+			return handle;
+		}
+		
+		void reserve(const std::size_t count)
+		{
+			values.reserve(count);
+			param_As.reserve(count);
+			param_Bs.reserve(count);
+			update_methods.reserve(count);
+			thresholds.reserve(count);
+			trigger_modes.reserve(count);
+			previous_values.reserve(count);
+			slot_of.reserve(count);
+			handle_of.reserve(count);
+		}
+		
+		void clear()
+		{
+			values.clear();
+			param_As.clear();
+			param_Bs.clear();
+			update_methods.clear();
+			thresholds.clear();
+			trigger_modes.clear();
+			slot_of.clear();
+			handle_of.clear();
+			active_count = 0;
+			trigger_count = 0;
+			triggered_handles.clear();
+			links.clear();
+			level_ends.clear();
+			level_link_ends.clear();
+			linked_count = 0;
+			links_dirty = false;
+		}
+		
+		std::size_t size() const
+		{
+			return values.size();
+		}
+		
+		bool empty() const
+		{
+			return values.empty();
+		}
+		
+		// the number of fields still being updated
+		std::size_t active_size() const
+		{
+			return active_count;
+		}
+		
+		bool is_sleeping(const handle_t field) const
+		{
+			return slot_of[field] >= active_count;
+		}
+		
+		// How close a field must come to its limit before it is snapped to it
+		// and put to sleep. A negative tolerance keeps every field awake.
+		void set_settle_tolerance(cfloat tolerance)
+		{
+			settle_tolerance = tolerance;
+		}
+		
+		float value(const handle_t field) const
+		{
+			return values[slot_of[field]];
+		}
+		
+		void set_value(const handle_t field, cfloat value_in)
+		{
+			const std::size_t slot = slot_of[field];
+			values[slot] = value_in;
+			wake(slot);
+		}
+		
+		void set_update_method(const handle_t field, const update_method_t update_method_in, cfloat param_A_in, cfloat param_B_in = 0)
+		{
+			const std::size_t slot = slot_of[field];
+			update_methods[slot] = static_cast<uint8_t>(update_method_in);
+			param_As[slot] = param_A_in;
+			param_Bs[slot] = param_B_in;
+			wake(slot);
+		}
+		
+		update_method_t update_method(const handle_t field) const
+		{
+			return static_cast<update_method_t>(update_methods[slot_of[field]]);
+		}
+		
+		// Watches for a field reaching a threshold, in the direction(s) given
+		// by the mode, such as a fade finishing or a timer running out. Fields
+		// that do so during an update are listed by triggered() afterwards.
+		void set_trigger(const handle_t field, cfloat threshold, const crossing_t mode = updating_field_kernels::RISING)
+		{
+			const std::size_t slot = slot_of[field];
+			trigger_count += (mode != updating_field_kernels::NO_CROSSING) - (trigger_modes[slot] != updating_field_kernels::NO_CROSSING);
+			thresholds[slot] = threshold;
+			trigger_modes[slot] = static_cast<uint8_t>(mode);
+		}
+		
+		void clear_trigger(const handle_t field)
+		{
+			set_trigger(field, 0, updating_field_kernels::NO_CROSSING);
+		}
+		
+		// the fields whose triggers fired during the last update, in no
+		// particular order
+		const std::vector<handle_t> & triggered() const
+		{
+			return triggered_handles;
+		}
+		
+		// Makes a parameter of the target take the value of the source field
+		// before every update, after the source itself has been updated; a
+		// speed field can drive the increment of a position, for example.
+		// Throws std::logic_error if the link would form a cycle.
+		void link(const handle_t target, const link_param_t param, const handle_t source)
+		{
+			if(depends_on(source, target))
+			{
+				throw std::logic_error("game_dev_utilities::updating_field_pool_t::link:: link would form a cycle.");
+			}
+			
+			unlink(target, param);
+			link_t l = {target, source, static_cast<uint8_t>(param), 0};
+			links.push_back(l);
+			links_dirty = true;
+		}
+		
+		void unlink(const handle_t target, const link_param_t param)
+		{
+			for(std::vector<link_t>::iterator itr = links.begin(); itr != links.end(); ++itr)
+			{
+				if(itr->target == target && itr->param == param)
+				{
+					links.erase(itr);
+					links_dirty = true;
+					return;
+				}
+			}
+		}
+		
+		void update()
+		{
+			advance(1.f, 0);
+		}
+		
+		// Splits the active fields into chunks of chunk_size and shares them
+		// across the workers. Fields are independent within a link level, so
+		// the result is identical to update() regardless of the number of
+		// threads.
+		void update(worker_pool_t & workers)
+		{
+			advance(1.f, &workers);
+		}
+		
+		// Advances every field by a possibly fractional number of ticks using
+		// updating_field_t::integrate, for updating at a variable rate.
+		void integrate(cfloat ticks)
+		{
+			advance(ticks, 0);
+		}
+		
+		void integrate(cfloat ticks, worker_pool_t & workers)
+		{
+			advance(ticks, &workers);
+		}
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_UPDATING_FIELD_POOL_HPP
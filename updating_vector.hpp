@@ -0,0 +1,317 @@
+/*
+*
+*	updating_vector.hpp
+*
+*   Two dimensional updating fields, for the positions and velocities of
+*   bullets, particles and the like. Both components share one update method,
+*   chosen once, rather than pairing two updating_field_t objects which each
+*   store and dispatch on their own method.
+*
+*   The x and y of a vector sit side by side in each of the value and
+*   parameter arrays, so a pool of vectors is updated as runs of packed floats
+*   with the bulk kernels from updating_field_kernels.hpp.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+
+#ifndef GAME_DEV_UTILITIES_UPDATING_VECTOR_HPP
+#define GAME_DEV_UTILITIES_UPDATING_VECTOR_HPP
+#include"updating_field.hpp"
+#include"updating_field_kernels.hpp"
+#include"aligned_allocator.hpp"
+#include"worker_pool.hpp"
+#include<vector>
+#include<algorithm>
+#include<stdint.h>
+namespace game_dev_utilities
+{
+
+class updating_vec2_t
+{
+	public:
+	
+		typedef updating_field_t::update_method_t update_method_t;
+		
+	private:
+	
+		float value[2];
+		float param_A[2];
+		float param_B[2];
+		update_method_t update_method;
+		
+	public:
+	
+		explicit updating_vec2_t(cfloat x_in = 0, cfloat y_in = 0):
+			update_method(updating_field_t::NOTHING)
+		{
+			value[0] = x_in;
+			value[1] = y_in;
+			param_A[0] = param_A[1] = 0;
+			param_B[0] = param_B[1] = 0;
+		}
+		
+		float x() const
+		{
+			return value[0];
+		}
+		
+		float y() const
+		{
+			return value[1];
+		}
+		
+		void set_value(cfloat x_in, cfloat y_in)
+		{
+			value[0] = x_in;
+			value[1] = y_in;
+		}
+		
+		// the parameters are given per component, as for two updating_field_t
+		void set_update_method(const update_method_t update_method_in, cfloat param_A_x, cfloat param_A_y, cfloat param_B_x = 0, cfloat param_B_y = 0)
+		{
+			update_method = update_method_in;
+			param_A[0] = param_A_x;
+			param_A[1] = param_A_y;
+			param_B[0] = param_B_x;
+			param_B[1] = param_B_y;
+		}
+		
+		void add(cfloat x_inc, cfloat y_inc)
+		{
+			set_update_method(updating_field_t::ADD, x_inc, y_inc);
+		}
+		void attenuate(cfloat x_target, cfloat y_target, cfloat close_in_ratio)
+		{
+			set_update_method(updating_field_t::ATTENUATE, x_target, y_target, close_in_ratio, close_in_ratio);
+		}
+		
+		void update()
+		{
+			updating_field_kernels::update_run(update_method, value, param_A, param_B, 2);
+		}
+		
+		void integrate(cfloat ticks)
+		{
+			updating_field_t::integrate(update_method, value[0], param_A[0], param_B[0], ticks);
+			updating_field_t::integrate(update_method, value[1], param_A[1], param_B[1], ticks);
+		}
+};
+
+
+/*
+*   A pool of 2D updating fields. Values and parameters are stored x, y, x, y
+*   in cache line aligned arrays, with one method per vector. Vectors added
+*   together with the same method are updated as one packed run.
+*/
+class updating_vec2_pool_t
+{
+	public:
+	
+		typedef updating_field_t::update_method_t update_method_t;
+		typedef unsigned int handle_t;
+		
+		// vectors per job when updating in parallel; see updating_field_pool_t
+		static const std::size_t chunk_size = 8 * cache_line_size;
+		
+	private:
+	
+		std::vector<float, aligned_allocator<float> > values;
+		std::vector<float, aligned_allocator<float> > param_As;
+		std::vector<float, aligned_allocator<float> > param_Bs;
+		std::vector<uint8_t, aligned_allocator<uint8_t> > update_methods;
+		
+		void update_range(const std::size_t begin, const std::size_t end)
+		{
+			updating_field_kernels::update_span(&update_methods[begin], &values[2*begin], &param_As[2*begin], &param_Bs[2*begin], end - begin, 2);
+		}
+		
+		void integrate_range(const std::size_t begin, const std::size_t end, cfloat ticks)
+		{
+			for(std::size_t f = 2*begin; f < 2*end; ++f)
+			{
+				updating_field_t::integrate(static_cast<update_method_t>(update_methods[f/2]), values[f], param_As[f], param_Bs[f], ticks);
+			}
+		}
+		
+		// a ticks of 1 steps the fields, otherwise they are integrated
+		struct chunk_job_t
+		{
+			updating_vec2_pool_t * pool;
+			float ticks;
+			
+			void operator()(const std::size_t chunk)
+			{
+				const std::size_t begin = chunk * chunk_size;
+				const std::size_t end = std::min(begin + chunk_size, pool->size());
+				if(ticks == 1.f)
+				{
+					pool->update_range(begin, end);
+				}
+				else
+				{
+					pool->integrate_range(begin, end, ticks);
+				}
+			}
+		};
+		
+	public:
+	
+		handle_t add(cfloat x, cfloat y, const update_method_t update_method_in = updating_field_t::NOTHING,
+			cfloat param_A_x = 0, cfloat param_A_y = 0, cfloat param_B_x = 0, cfloat param_B_y = 0)
+		{
+			values.push_back(x);
+			values.push_back(y);
+			param_As.push_back(param_A_x);
+			param_As.push_back(param_A_y);
+			param_Bs.push_back(param_B_x);
+			param_Bs.push_back(param_B_y);
+			update_methods.push_back(static_cast<uint8_t>(update_method_in));
+			return static_cast<handle_t>(update_methods.size() - 1);
+		}
+		
+		// adds count vectors sharing one method and parameters, returning the
+		// handle of the first; the rest follow consecutively
+		handle_t add_many(const std::size_t count, const float * xy, const update_method_t update_method_in,
+			cfloat param_A_x = 0, cfloat param_A_y = 0, cfloat param_B_x = 0, cfloat param_B_y = 0)
+		{
+			const handle_t first = static_cast<handle_t>(size());
+			
+			values.insert(values.end(), xy, xy + 2*count);
+			update_methods.insert(update_methods.end(), count, static_cast<uint8_t>(update_method_in));
+			for(std::size_t v = 0; v < count; ++v)
+			{
+				param_As.push_back(param_A_x);
+				param_As.push_back(param_A_y);
+				param_Bs.push_back(param_B_x);
+				param_Bs.push_back(param_B_y);
+			}
+			return first;
+		}
+		
+		void reserve(const std::size_t count)
+		{
+			values.reserve(2*count);
+			param_As.reserve(2*count);
+			param_Bs.reserve(2*count);
+			update_methods.reserve(count);
+		}
+		
+		void clear()
+		{
+			values.clear();
+			param_As.clear();
+			param_Bs.clear();
+			update_methods.clear();
+		}
+		
+		std::size_t size() const
+		{
+			return update_methods.size();
+		}
+		
+		bool empty() const
+		{
+			return update_methods.empty();
+		}
+		
+		float x(const handle_t vector) const
+		{
+			return values[2*vector];
+		}
+		
+		float y(const handle_t vector) const
+		{
+			return values[2*vector + 1];
+		}
+		
+		// the packed x, y pairs of every vector in the pool
+		const float * data() const
+		{
+			return values.empty() ? 0 : &values[0];
+		}
+		
+		void set_value(const handle_t vector, cfloat x_in, cfloat y_in)
+		{
+			values[2*vector] = x_in;
+			values[2*vector + 1] = y_in;
+		}
+		
+		void set_update_method(const handle_t vector, const update_method_t update_method_in,
+			cfloat param_A_x, cfloat param_A_y, cfloat param_B_x = 0, cfloat param_B_y = 0)
+		{
+			update_methods[vector] = static_cast<uint8_t>(update_method_in);
+			param_As[2*vector] = param_A_x;
+			param_As[2*vector + 1] = param_A_y;
+			param_Bs[2*vector] = param_B_x;
+			param_Bs[2*vector + 1] = param_B_y;
+		}
+		
+		void update()
+		{
+			if(!empty())
+			{
+				update_range(0, size());
+			}
+		}
+		
+		void update(worker_pool_t & workers)
+		{
+			if(size() <= chunk_size || workers.size() == 1)
+			{
+				update();
+				return;
+			}
+			
+			chunk_job_t job = {this, 1.f};
+			workers.run((size() + chunk_size - 1) / chunk_size, job);
+		}
+		
+		// Advances every field by a possibly fractional number of ticks using
+		// updating_field_t::integrate, for updating at a variable rate.
+		void integrate(cfloat ticks)
+		{
+			integrate_range(0, size(), ticks);
+		}
+		
+		void integrate(cfloat ticks, worker_pool_t & workers)
+		{
+			if(size() <= chunk_size || workers.size() == 1)
+			{
+				integrate(ticks);
+				return;
+			}
+			
+			chunk_job_t job = {this, ticks};
+			workers.run((size() + chunk_size - 1) / chunk_size, job);
+		}
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_UPDATING_VECTOR_HPP
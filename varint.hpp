@@ -0,0 +1,366 @@
+/*
+*
+*    varint.hpp - compact integer encoding, as an opt in alternative to the
+*    full width integers of io.hpp
+*
+*    Values are stored as LEB128 varints, seven bits to a byte with the high
+*    bit set on all but the last byte, so small values take a single byte.
+*    Signed values are zigzag encoded first (0, -1, 1, -2 ... become 0, 1, 2,
+*    3 ...) so that small negative values stay small too.
+*
+*    write_compact and read_compact work with std::streams, binary_writer_t
+*    and binary_reader_t alike. Array reads from a binary_reader_t decode
+*    straight out of its buffer, eight bytes at a time.
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_VARINT_HPP
+#define GAME_DEV_UTILITIES_VARINT_HPP
+#include"io.hpp"
+#include"binary_io.hpp"
+#include"byte_order.hpp"
+#include<cstring>
+#include<stdint.h>
+#ifdef _MSC_VER
+#include<intrin.h>
+#endif
+namespace game_dev_utilities
+{
+
+static const std::size_t max_varint_size = 10;
+
+// the most elements read_compact(in, container) adds before reading them
+static const std::size_t compact_read_block = 4096;
+
+////////////////////////////////////////////////////////////////////////////////
+//  Zigzag
+////////////////////////////////////////////////////////////////////////////////
+
+inline uint64_t zigzag_encode(const int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(const uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// each type to and from the unsigned value that is varint encoded
+inline uint64_t to_compact(const uint64_t value) { return value; }
+inline uint64_t to_compact(const uint32_t value) { return value; }
+inline uint64_t to_compact(const uint16_t value) { return value; }
+inline uint64_t to_compact(const uint8_t value) { return value; }
+inline uint64_t to_compact(const int64_t value) { return zigzag_encode(value); }
+inline uint64_t to_compact(const int32_t value) { return zigzag_encode(value); }
+inline uint64_t to_compact(const int16_t value) { return zigzag_encode(value); }
+inline uint64_t to_compact(const int8_t value) { return zigzag_encode(value); }
+
+// values too wide for the type are truncated, as with a cast
+inline void from_compact(const uint64_t compact, uint64_t & value) { value = compact; }
+inline void from_compact(const uint64_t compact, uint32_t & value) { value = static_cast<uint32_t>(compact); }
+inline void from_compact(const uint64_t compact, uint16_t & value) { value = static_cast<uint16_t>(compact); }
+inline void from_compact(const uint64_t compact, uint8_t & value) { value = static_cast<uint8_t>(compact); }
+inline void from_compact(const uint64_t compact, int64_t & value) { value = zigzag_decode(compact); }
+inline void from_compact(const uint64_t compact, int32_t & value) { value = static_cast<int32_t>(zigzag_decode(compact)); }
+inline void from_compact(const uint64_t compact, int16_t & value) { value = static_cast<int16_t>(zigzag_decode(compact)); }
+inline void from_compact(const uint64_t compact, int8_t & value) { value = static_cast<int8_t>(zigzag_decode(compact)); }
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Varints in memory
+////////////////////////////////////////////////////////////////////////////////
+
+// returns the bytes written, at most max_varint_size
+inline std::size_t encode_varint(uint64_t value, unsigned char * out)
+{
+    std::size_t size = 0;
+    while (value >= 0x80)
+    {
+        out[size++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<unsigned char>(value);
+    return size;
+}
+
+// returns the bytes read, or 0 if the varint is cut short or too long
+inline std::size_t decode_varint(const unsigned char * in, const std::size_t available, uint64_t & value)
+{
+    uint64_t result = 0;
+    for (std::size_t b = 0; b < available && b < max_varint_size; ++b)
+    {
+        result |= static_cast<uint64_t>(in[b] & 0x7F) << (7 * b);
+        if (!(in[b] & 0x80))
+        {
+            value = result;
+            return b + 1;
+        }
+    }
+    return 0;
+}
+
+inline unsigned int lowest_set_bit(const uint64_t value)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+    #else
+    unsigned int index = 0;
+    while (!((value >> index) & 1))
+    {
+        ++index;
+    }
+    return index;
+    #endif
+}
+
+/*
+*   Decodes up to count varints, stopping early at one which is cut short by the
+*   end of the input. Returns the number decoded and sets bytes_used.
+*
+*   Any varint of up to eight bytes that has eight bytes of input behind it is
+*   decoded with a single load: the first byte without a continuation bit gives
+*   the length, and the seven bit groups are folded together without a loop.
+*/
+inline std::size_t decode_varints(const unsigned char * in, const std::size_t available,
+    uint64_t * values, const std::size_t count, std::size_t & bytes_used)
+{
+    const unsigned char * position = in;
+    const unsigned char * end = in + available;
+    std::size_t decoded = 0;
+
+    for (; decoded < count; ++decoded)
+    {
+        if (end - position >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, position, 8);
+            little_endian_to_host(&word, 1, 8);
+
+            const uint64_t stops = ~word & 0x8080808080808080ULL;
+            if (stops)
+            {
+                const unsigned int length = (lowest_set_bit(stops) + 1) / 8;
+                if (length < 8)
+                {
+                    word &= (static_cast<uint64_t>(1) << (8 * length)) - 1;
+                }
+
+                values[decoded] = (word & 0x7FULL)
+                    | ((word >> 1) & (0x7FULL << 7))
+                    | ((word >> 2) & (0x7FULL << 14))
+                    | ((word >> 3) & (0x7FULL << 21))
+                    | ((word >> 4) & (0x7FULL << 28))
+                    | ((word >> 5) & (0x7FULL << 35))
+                    | ((word >> 6) & (0x7FULL << 42))
+                    | ((word >> 7) & (0x7FULL << 49));
+                position += length;
+                continue;
+            }
+        }
+
+        const std::size_t used = decode_varint(position, end - position, values[decoded]);
+        if (!used)
+        {
+            break;
+        }
+        position += used;
+    }
+
+    bytes_used = position - in;
+    return decoded;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Varints on streams
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename Out>
+inline Out& write_varint(Out& out, const uint64_t value)
+{
+    unsigned char buffer[max_varint_size];
+    out.write((const char*)(buffer), encode_varint(value, buffer));
+    return out;
+}
+
+template<typename In>
+inline In& read_varint(In& in, uint64_t & value)
+{
+    value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = 0;
+        if (!read(in, byte))
+        {
+            return in;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            break;
+        }
+    }
+    return in;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compact scalars, arrays and containers
+////////////////////////////////////////////////////////////////////////////////
+
+#define GAME_DEV_UTILITIES_COMPACT_TYPE(TYPE) \
+    template<typename Out> \
+    inline Out& write_compact(Out& out, const TYPE value) \
+    { \
+        return write_varint(out, to_compact(value)); \
+    } \
+    template<typename In> \
+    inline In& read_compact(In& in, TYPE & value) \
+    { \
+        uint64_t compact = 0; \
+        read_varint(in, compact); \
+        from_compact(compact, value); \
+        return in; \
+    }
+
+GAME_DEV_UTILITIES_COMPACT_TYPE(uint64_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(uint32_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(uint16_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(uint8_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(int64_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(int32_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(int16_t)
+GAME_DEV_UTILITIES_COMPACT_TYPE(int8_t)
+
+#undef GAME_DEV_UTILITIES_COMPACT_TYPE
+
+template<typename Out, typename T>
+inline Out& write_compact(Out& out, const T * values, const size_t count)
+{
+    unsigned char buffer[64 * max_varint_size];
+    std::size_t used = 0;
+
+    for (size_t v = 0; v < count; ++v)
+    {
+        if (used > sizeof(buffer) - max_varint_size)
+        {
+            out.write((const char*)(buffer), used);
+            used = 0;
+        }
+        used += encode_varint(to_compact(values[v]), buffer + used);
+    }
+    out.write((const char*)(buffer), used);
+    return out;
+}
+
+template<typename In, typename T>
+inline In& read_compact(In& in, T * values, const size_t count)
+{
+    for (size_t v = 0; v < count && in; ++v)
+    {
+        read_compact(in, values[v]);
+    }
+    return in;
+}
+
+// decodes whole runs out of the reader's buffer, refilling it one value at a time
+template<typename T>
+inline binary_reader_t& read_compact(binary_reader_t& in, T * values, const size_t count)
+{
+    uint64_t decoded[64];
+    size_t done = 0;
+
+    while (done < count && in)
+    {
+        const std::size_t wanted = count - done < 64? count - done : 64;
+        std::size_t bytes_used = 0;
+        const std::size_t got = decode_varints(reinterpret_cast<const unsigned char*>(in.buffered_data()),
+            in.buffered(), decoded, wanted, bytes_used);
+
+        in.consume(bytes_used);
+        for (std::size_t v = 0; v < got; ++v)
+        {
+            from_compact(decoded[v], values[done + v]);
+        }
+        done += got;
+
+        if (got < wanted)
+        {
+            read_compact(in, values[done]);
+            ++done;
+        }
+    }
+    return in;
+}
+
+// as write(out, container), with a compact count followed by compact values
+template<typename Out, typename C>
+inline Out& write_compact(Out& out, const C & container)
+{
+    write_varint(out, container.size());
+    if (! container.empty())
+    {
+        write_compact(out, &container[0], container.size());
+    }
+    return out;
+}
+
+// read in place a block at a time, so a corrupt count runs out of data before
+// it runs out of memory; on failure the container is left as it was
+template<typename In, typename C>
+inline In& read_compact(In& in, C & container)
+{
+    uint64_t size = 0;
+    read_varint(in, size);
+
+    const std::size_t old_size = container.size();
+    for (uint64_t done = 0; done < size && in; )
+    {
+        const std::size_t n = static_cast<std::size_t>(size - done < compact_read_block? size - done : compact_read_block);
+        const std::size_t at = container.size();
+        container.resize(at + n);
+        read_compact(in, &container[at], n);
+        done += n;
+    }
+    if (! in)
+    {
+        container.resize(old_size);
+    }
+    return in;
+}
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_VARINT_HPP
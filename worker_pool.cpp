@@ -0,0 +1,150 @@
+/*
+*
+*    worker_pool.cpp - a small persistent pool of worker threads for splitting
+*    a batch of independent jobs, such as chunks of field storage, across cores
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include"worker_pool.hpp"
+namespace game_dev_utilities
+{
+
+unsigned int worker_pool_t::default_worker_count()
+{
+    const unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+worker_pool_t::worker_pool_t(const unsigned int worker_count):
+    job_function(0),
+    job_context(0),
+    job_count(0),
+    next_job(0),
+    batch(0),
+    busy_workers(0),
+    stopping(false)
+{
+    workers.reserve(worker_count);
+    for (unsigned int t = 0; t < worker_count; ++t)
+    {
+        workers.push_back(std::thread(&worker_pool_t::work_loop, this));
+    }
+}
+
+worker_pool_t::~worker_pool_t()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    batch_started.notify_all();
+
+    for (std::vector<std::thread>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+    {
+        itr->join();
+    }
+}
+
+void worker_pool_t::run_jobs(const std::size_t count, job_function_t function, void * context)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (workers.empty() || count == 1)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            function(context, index);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job_function = function;
+        job_context = context;
+        job_count = count;
+        next_job.store(0);
+        busy_workers = static_cast<unsigned int>(workers.size());
+        ++batch;
+    }
+    batch_started.notify_all();
+
+    take_jobs();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (busy_workers)
+    {
+        batch_finished.wait(lock);
+    }
+}
+
+void worker_pool_t::take_jobs()
+{
+    for (std::size_t index = next_job++; index < job_count; index = next_job++)
+    {
+        job_function(job_context, index);
+    }
+}
+
+void worker_pool_t::work_loop()
+{
+    unsigned long seen_batch = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping && seen_batch == batch)
+            {
+                batch_started.wait(lock);
+            }
+            if (stopping)
+            {
+                return;
+            }
+            seen_batch = batch;
+        }
+
+        take_jobs();
+
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = (--busy_workers == 0);
+        }
+        if (last)
+        {
+            batch_finished.notify_one();
+        }
+    }
+}
+
+
+} // namespace game_dev_utilities
@@ -0,0 +1,110 @@
+/*
+*
+*    worker_pool.hpp - a small persistent pool of worker threads for splitting
+*    a batch of independent jobs, such as chunks of field storage, across cores
+*
+--------------------------------------------------------------------------------
+
+MIT License
+
+Copyright (c) 2016 Antony Alastair Brown, MrTAB on GitHub
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+
+#pragma once
+#ifndef GAME_DEV_UTILITIES_WORKER_POOL_HPP
+#define GAME_DEV_UTILITIES_WORKER_POOL_HPP
+#include<cstddef>
+#include<vector>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+namespace game_dev_utilities
+{
+
+/*
+*   Threads are created once and sleep between batches. The calling thread
+*   takes part in every batch, so a pool of zero workers simply runs the jobs
+*   in place. Jobs are handed out one index at a time; which thread runs a job
+*   is not fixed, so jobs must not depend on each other.
+*/
+class worker_pool_t
+{
+    public:
+
+        // worker_count threads besides the caller; by default one per extra core
+        explicit worker_pool_t(const unsigned int worker_count = default_worker_count());
+        ~worker_pool_t();
+
+        // number of threads that take part in a batch, including the caller
+        unsigned int size() const
+        {
+            return static_cast<unsigned int>(workers.size()) + 1;
+        }
+
+        // calls job(index) for every index in [0, job_count) and returns once
+        // all have completed
+        template<typename F>
+        void run(const std::size_t job_count, F & job)
+        {
+            run_jobs(job_count, &invoke<F>, &job);
+        }
+
+        static unsigned int default_worker_count();
+
+    private:
+
+        typedef void (*job_function_t)(void*, std::size_t);
+
+        template<typename F>
+        static void invoke(void * context, const std::size_t index)
+        {
+            (*static_cast<F*>(context))(index);
+        }
+
+        void run_jobs(const std::size_t job_count, job_function_t function, void * context);
+        void work_loop();
+        void take_jobs();
+
+        worker_pool_t(const worker_pool_t&);
+        worker_pool_t& operator = (const worker_pool_t&);
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable batch_started;
+        std::condition_variable batch_finished;
+
+        job_function_t job_function;
+        void * job_context;
+        std::size_t job_count;
+        std::atomic<std::size_t> next_job;
+
+        unsigned long batch;
+        unsigned int busy_workers;
+        bool stopping;
+};
+
+
+} // namespace game_dev_utilities
+#endif // GAME_DEV_UTILITIES_WORKER_POOL_HPP